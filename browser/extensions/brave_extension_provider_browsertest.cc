@@ -11,6 +11,7 @@
 #include "brave/common/brave_paths.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/url_constants.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "chrome/browser/extensions/crx_installer.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
@@ -71,6 +72,12 @@ IN_PROC_BROWSER_TEST_F(BraveExtensionProviderTest,
       "addImage('ad_banner.png')",
       &as_expected));
   EXPECT_TRUE(as_expected);
+  // Blocked counters are buffered per tab, so flush them before reading prefs.
+  brave_shields::BraveShieldsWebContentsObserver* observer =
+      brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+          contents);
+  if (observer)
+    observer->FlushStats();
   EXPECT_EQ(browser()->profile()->GetPrefs()->GetUint64(kAdsBlocked), 0ULL);
 }
 
@@ -9,82 +9,82 @@
 #include <string>
 
 #include "base/base64url.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/browser/net/url_context.h"
 #include "brave/common/network_constants.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/grit/brave_generated_resources.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "extensions/common/url_pattern.h"
 #include "ui/base/resource/resource_bundle.h"
 
 namespace brave {
 
-void ShouldBlockAdOnTaskRunner(std::shared_ptr<BraveRequestInfo> ctx) {
+void ShouldBlockAd(std::shared_ptr<BraveRequestInfo> ctx) {
+  // The request features are shared by every engine, so compute them once.
+  const brave_shields::AdBlockRequest request(
+      ctx->request_url, ctx->resource_type, ctx->tab_origin.host());
+
+  brave_shields::AdBlockDecisionCache* cache =
+      brave_shields::AdBlockDecisionCache::GetInstance();
+  const std::string cache_key =
+      brave_shields::AdBlockDecisionCache::MakeKey(request);
+  brave_shields::AdBlockDecisionCache::Decision decision;
+  const bool cache_hit = cache->Get(cache_key, &decision);
+  UMA_HISTOGRAM_BOOLEAN("Brave.AdBlock.DecisionCacheHit", cache_hit);
+  if (cache_hit) {
+    if (decision.should_block) {
+      ctx->blocked_by = kAdBlocked;
+      ctx->cancel_request_explicitly = decision.cancel_request_explicitly;
+      ctx->mock_data_url = decision.mock_data_url;
+    }
+    return;
+  }
+
+  const uint64_t generation = cache->generation();
   bool did_match_exception = false;
-  std::string tab_host = ctx->tab_origin.host();
   if (!g_brave_browser_process->ad_block_service()->ShouldStartRequest(
-          ctx->request_url, ctx->resource_type, tab_host,
-          &did_match_exception, &ctx->cancel_request_explicitly,
+          request, &did_match_exception, &ctx->cancel_request_explicitly,
           &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_regional_service_manager()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly,
                                        &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   } else if (!did_match_exception &&
              !g_brave_browser_process->ad_block_custom_filters_service()
-                  ->ShouldStartRequest(ctx->request_url, ctx->resource_type,
-                                       tab_host, &did_match_exception,
+                  ->ShouldStartRequest(request, &did_match_exception,
                                        &ctx->cancel_request_explicitly,
                                        &ctx->mock_data_url)) {
     ctx->blocked_by = kAdBlocked;
   }
-}
 
-void OnShouldBlockAdResult(const ResponseCallback& next_callback,
-                           std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  if (ctx->blocked_by == kAdBlocked) {
-    brave_shields::DispatchBlockedEvent(
-        ctx->request_url,
-        ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
-        brave_shields::kAds);
+  decision.should_block = ctx->blocked_by == kAdBlocked;
+  if (decision.should_block) {
+    decision.cancel_request_explicitly = ctx->cancel_request_explicitly;
+    decision.mock_data_url = ctx->mock_data_url;
   }
-  next_callback.Run();
-}
-
-void OnBeforeURLRequestAdBlockTP(
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  // If the following info isn't available, then proper content settings can't
-  // be looked up, so do nothing.
-  if (ctx->tab_origin.is_empty() || !ctx->tab_origin.has_host() ||
-      ctx->request_url.is_empty()) {
-    return;
-  }
-  DCHECK_NE(ctx->request_identifier, 0UL);
-
-  g_brave_browser_process->ad_block_service()->GetTaskRunner()
-      ->PostTaskAndReply(FROM_HERE,
-                         base::BindOnce(&ShouldBlockAdOnTaskRunner, ctx),
-                         base::BindOnce(&OnShouldBlockAdResult, next_callback,
-                                        ctx));
+  cache->Put(cache_key, decision, generation);
 }
 
 int OnBeforeURLRequest_AdBlockTPPreWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT0("browser", "OnBeforeURLRequest_AdBlockTPPreWork");
 
   if (ctx->request_url.is_empty()) {
     return net::OK;
@@ -92,15 +92,26 @@ int OnBeforeURLRequest_AdBlockTPPreWork(
 
   // If the following info isn't available, then proper content settings can't
   // be looked up, so do nothing.
-  if (ctx->tab_origin.is_empty() || !ctx->allow_brave_shields ||
-      ctx->allow_ads ||
+  if (ctx->tab_origin.is_empty() || !ctx->tab_origin.has_host() ||
+      !ctx->allow_brave_shields || ctx->allow_ads ||
       ctx->resource_type == BraveRequestInfo::kInvalidResourceType) {
     return net::OK;
   }
+  DCHECK_NE(ctx->request_identifier, 0UL);
 
-  OnBeforeURLRequestAdBlockTP(next_callback, ctx);
+  // Published adblock engines are immutable and the request callbacks run on
+  // the thread pool, so matching happens inline without another thread hop.
+  ShouldBlockAd(ctx);
+  if (ctx->blocked_by == kAdBlocked) {
+    base::PostTask(
+        FROM_HERE, {content::BrowserThread::UI},
+        base::BindOnce(&brave_shields::DispatchBlockedEvent, ctx->request_url,
+                       ctx->render_frame_id, ctx->render_process_id,
+                       ctx->frame_tree_node_id,
+                       std::string(brave_shields::kAds)));
+  }
 
-  return net::ERR_IO_PENDING;
+  return net::OK;
 }
 
 }  // namespace brave
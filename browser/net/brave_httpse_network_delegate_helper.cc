@@ -11,16 +11,32 @@
 
 #include "base/task/post_task.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/https_everywhere_service.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 
 using content::BrowserThread;
 
 namespace brave {
 
+namespace {
+
+void DispatchHTTPUpgradableResourceBlockedEvent(
+    std::shared_ptr<BraveRequestInfo> ctx) {
+  base::PostTask(
+      FROM_HERE, {BrowserThread::UI},
+      base::BindOnce(&brave_shields::DispatchBlockedEvent, ctx->request_url,
+                     ctx->render_frame_id, ctx->render_process_id,
+                     ctx->frame_tree_node_id,
+                     std::string(brave_shields::kHTTPUpgradableResources)));
+}
+
+}  // namespace
+
 void OnBeforeURLRequest_HttpseFileWork(
     std::shared_ptr<BraveRequestInfo> ctx) {
   base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
@@ -33,13 +49,9 @@ void OnBeforeURLRequest_HttpseFileWork(
 void OnBeforeURLRequest_HttpsePostFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(BrowserThread::UI);
-
   if (!ctx->new_url_spec.empty() &&
     ctx->new_url_spec != ctx->request_url.spec()) {
-    brave_shields::DispatchBlockedEvent(ctx->request_url,
-        ctx->render_frame_id, ctx->render_process_id, ctx->frame_tree_node_id,
-        brave_shields::kHTTPUpgradableResources);
+    DispatchHTTPUpgradableResourceBlockedEvent(ctx);
   }
 
   next_callback.Run();
@@ -48,7 +60,7 @@ void OnBeforeURLRequest_HttpsePostFileWork(
 int OnBeforeURLRequest_HttpsePreFileWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  TRACE_EVENT0("browser", "OnBeforeURLRequest_HttpsePreFileWork");
 
   // Don't try to overwrite an already set URL by another delegate (adblock/tp)
   if (!ctx->new_url_spec.empty()) {
@@ -84,10 +96,7 @@ int OnBeforeURLRequest_HttpsePreFileWork(
       return net::ERR_IO_PENDING;
     } else {
       if (!ctx->new_url_spec.empty()) {
-        brave_shields::DispatchBlockedEvent(ctx->request_url,
-            ctx->render_frame_id, ctx->render_process_id,
-            ctx->frame_tree_node_id,
-            brave_shields::kHTTPUpgradableResources);
+        DispatchHTTPUpgradableResourceBlockedEvent(ctx);
       }
     }
   }
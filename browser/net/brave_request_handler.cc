@@ -10,6 +10,8 @@
 
 #include "base/metrics/histogram_macros.h"
 #include "base/task/post_task.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
 #include "brave/browser/net/brave_common_static_redirect_network_delegate_helper.h"
 #include "brave/browser/net/brave_httpse_network_delegate_helper.h"
@@ -60,28 +62,31 @@ BraveRequestHandler::BraveRequestHandler() {
 BraveRequestHandler::~BraveRequestHandler() = default;
 
 void BraveRequestHandler::SetupCallbacks() {
+  before_url_request_callbacks_ =
+      base::MakeRefCounted<BeforeURLRequestCallbacks>();
+
   brave::OnBeforeURLRequestCallback callback =
       base::Bind(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 
   callback = base::Bind(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 
   callback = base::Bind(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 
   callback = base::Bind(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 
 #if BUILDFLAG(BRAVE_REWARDS_ENABLED)
   callback = base::Bind(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 #endif
 
 #if BUILDFLAG(ENABLE_BRAVE_TRANSLATE_GO)
   callback =
       base::BindRepeating(brave::OnBeforeURLRequest_TranslateRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+  before_url_request_callbacks_->data.push_back(callback);
 #endif
 
   brave::OnBeforeStartTransactionCallback start_transaction_callback =
@@ -133,14 +138,27 @@ int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (before_url_request_callbacks_->data.empty() || IsInternalScheme(ctx)) {
     return net::OK;
   }
-  SCOPED_UMA_HISTOGRAM_TIMER("Brave.OnBeforeURLRequest_Handler");
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(
+      "browser", "BraveRequestHandler::OnBeforeURLRequest",
+      TRACE_ID_LOCAL(ctx->request_identifier));
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
   callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
+
+  // The callbacks only read and update |ctx|, so they run off the UI thread.
+  // Each request gets its own sequence so that requests don't queue behind
+  // each other, and helpers which need WebContents post to UI themselves.
+  base::CreateSequencedTaskRunner(
+      {base::ThreadPool(), base::TaskPriority::USER_BLOCKING})
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(
+                     &BraveRequestHandler::RunBeforeURLRequestCallbacks,
+                     weak_factory_.GetWeakPtr(), before_url_request_callbacks_,
+                     base::TimeTicks::Now(), ctx));
   return net::ERR_IO_PENDING;
 }
 
@@ -205,6 +223,83 @@ void BraveRequestHandler::RunCallbackForRequestIdentifier(
                  base::BindOnce(std::move(it->second), rv));
 }
 
+// static
+void BraveRequestHandler::RunBeforeURLRequestCallbacks(
+    base::WeakPtr<BraveRequestHandler> handler,
+    scoped_refptr<BeforeURLRequestCallbacks> callbacks,
+    base::TimeTicks start_time,
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_EQ(ctx->event_type, brave::kOnBeforeRequest);
+  TRACE_EVENT0("browser", "BraveRequestHandler::RunBeforeURLRequestCallbacks");
+
+  // Continue processing callbacks until we hit one that returns PENDING
+  int rv = net::OK;
+  while (callbacks->data.size() != ctx->next_url_request_index) {
+    const brave::OnBeforeURLRequestCallback& callback =
+        callbacks->data[ctx->next_url_request_index++];
+    brave::ResponseCallback next_callback = base::BindRepeating(
+        &BraveRequestHandler::RunBeforeURLRequestCallbacks,
+        handler,
+        callbacks,
+        start_time,
+        ctx);
+    rv = callback.Run(next_callback, ctx);
+    if (rv == net::ERR_IO_PENDING) {
+      return;
+    }
+    if (rv != net::OK) {
+      break;
+    }
+  }
+
+  base::PostTask(
+      FROM_HERE, {content::BrowserThread::UI},
+      base::BindOnce(&BraveRequestHandler::OnBeforeURLRequestCallbacksDone,
+                     handler, start_time, ctx, rv));
+}
+
+// static
+void BraveRequestHandler::OnBeforeURLRequestCallbacksDone(
+    base::WeakPtr<BraveRequestHandler> handler,
+    base::TimeTicks start_time,
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    int rv) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  // Close the trace event and record the timing even if the handler is gone,
+  // so that every OnBeforeURLRequest which went async is accounted for.
+  TRACE_EVENT_NESTABLE_ASYNC_END0(
+      "browser", "BraveRequestHandler::OnBeforeURLRequest",
+      TRACE_ID_LOCAL(ctx->request_identifier));
+  UMA_HISTOGRAM_TIMES("Brave.OnBeforeURLRequest_Handler",
+                      base::TimeTicks::Now() - start_time);
+
+  if (!handler) {
+    return;
+  }
+
+  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
+      handler->callbacks_.find(ctx->request_identifier);
+  if (it == handler->callbacks_.end()) {
+    // The request was destroyed while the callbacks were running.
+    return;
+  }
+
+  if (rv == net::OK) {
+    if (!ctx->new_url_spec.empty() &&
+        (ctx->new_url_spec != ctx->request_url.spec())) {
+      *ctx->new_url = GURL(ctx->new_url_spec);
+    }
+    if (ctx->blocked_by == brave::kAdBlocked &&
+        ctx->cancel_request_explicitly) {
+      rv = net::ERR_ABORTED;
+    }
+  }
+
+  // We are already in a task posted after OnBeforeURLRequest returned, so the
+  // callback can run directly.
+  std::move(it->second).Run(rv);
+}
+
 // TODO(iefremov): Merge all callback containers into one and run only one loop
 // instead of many (issues/5574).
 void BraveRequestHandler::RunNextCallback(
@@ -218,24 +313,7 @@ void BraveRequestHandler::RunNextCallback(
   // Continue processing callbacks until we hit one that returns PENDING
   int rv = net::OK;
 
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback = base::Bind(
-          &BraveRequestHandler::RunNextCallback,
-          weak_factory_.GetWeakPtr(),
-          ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
-    }
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
+  if (ctx->event_type == brave::kOnBeforeStartTransaction) {
     while (before_start_transaction_callbacks_.size() !=
            ctx->next_url_request_index) {
       brave::OnBeforeStartTransactionCallback callback =
@@ -272,24 +350,5 @@ void BraveRequestHandler::RunNextCallback(
     }
   }
 
-  if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
-  }
-
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    if (!ctx->new_url_spec.empty() &&
-        (ctx->new_url_spec != ctx->request_url.spec()) &&
-        IsRequestIdentifierValid(ctx->request_identifier)) {
-      *ctx->new_url = GURL(ctx->new_url_spec);
-    }
-    if (ctx->blocked_by == brave::kAdBlocked) {
-      if (ctx->cancel_request_explicitly) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_ABORTED);
-        return;
-      }
-    }
-  }
   RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
 }
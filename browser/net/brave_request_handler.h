@@ -11,6 +11,9 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "brave/browser/net/url_context.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/completion_once_callback.h"
@@ -46,6 +49,22 @@ class BraveRequestHandler {
   void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
+  using BeforeURLRequestCallbacks =
+      base::RefCountedData<std::vector<brave::OnBeforeURLRequestCallback>>;
+
+  // Runs the remaining |callbacks| for |ctx| on a thread pool sequence and
+  // reports the result back to |handler| on the UI thread.
+  static void RunBeforeURLRequestCallbacks(
+      base::WeakPtr<BraveRequestHandler> handler,
+      scoped_refptr<BeforeURLRequestCallbacks> callbacks,
+      base::TimeTicks start_time,
+      std::shared_ptr<brave::BraveRequestInfo> ctx);
+  static void OnBeforeURLRequestCallbacksDone(
+      base::WeakPtr<BraveRequestHandler> handler,
+      base::TimeTicks start_time,
+      std::shared_ptr<brave::BraveRequestInfo> ctx,
+      int rv);
+
   void SetupCallbacks();
   void InitPrefChangeRegistrar();
   void OnReferralHeadersChanged();
@@ -54,7 +73,9 @@ class BraveRequestHandler {
 
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
+  // Shared with the thread pool tasks running the callbacks, which may
+  // outlive this handler.
+  scoped_refptr<BeforeURLRequestCallbacks> before_url_request_callbacks_;
   std::vector<brave::OnBeforeStartTransactionCallback>
       before_start_transaction_callbacks_;
   std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
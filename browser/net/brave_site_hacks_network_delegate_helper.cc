@@ -9,10 +9,12 @@
 #include <string>
 #include <vector>
 
-#include "base/lazy_instance.h"
+#include "base/containers/flat_set.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/common/network_constants.h"
 #include "brave/common/shield_exceptions.h"
 #include "brave/common/url_constants.h"
@@ -20,67 +22,70 @@
 #include "content/public/common/referrer.h"
 #include "extensions/common/url_pattern.h"
 #include "net/url_request/url_request.h"
-#include "third_party/re2/src/re2/re2.h"
 
 namespace brave {
 
 namespace {
 
-const std::string& GetQueryStringTrackers() {
-  static const base::NoDestructor<std::string> trackers(base::JoinString(
-      std::vector<std::string>(
+struct CaseInsensitiveCompare {
+  bool operator()(base::StringPiece a, base::StringPiece b) const {
+    return base::CompareCaseInsensitiveASCII(a, b) < 0;
+  }
+};
+
+using QueryStringTrackers =
+    base::flat_set<base::StringPiece, CaseInsensitiveCompare>;
+
+const QueryStringTrackers& GetQueryStringTrackers() {
+  static const base::NoDestructor<QueryStringTrackers> trackers(
+      std::initializer_list<base::StringPiece>(
           {// https://github.com/brave/brave-browser/issues/4239
            "fbclid", "gclid", "msclkid", "mc_eid",
            // https://github.com/brave/brave-browser/issues/9879
            "dclid",
            // https://github.com/brave/brave-browser/issues/9019
-           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}),
-      "|"));
+           "_hsenc", "__hssc", "__hstc", "__hsfp", "hsCtaTracking"}));
   return *trackers;
 }
 
-// From src/components/autofill/content/renderer/page_passwords_analyser.cc
-// and password_form_conversion_utils.cc:
-#define DECLARE_LAZY_MATCHER(NAME, PATTERN)                                   \
-  struct LabelPatternLazyInstanceTraits_##NAME                                \
-      : public base::internal::DestructorAtExitLazyInstanceTraits<re2::RE2> { \
-    static re2::RE2* New(void* instance) {                                    \
-      re2::RE2::Options options;                                              \
-      options.set_case_sensitive(false);                                      \
-      re2::RE2* matcher = new (instance) re2::RE2(PATTERN, options);          \
-      DCHECK(matcher->ok());                                                  \
-      return matcher;                                                         \
-    }                                                                         \
-  };                                                                          \
-  base::LazyInstance<re2::RE2, LabelPatternLazyInstanceTraits_##NAME> NAME =  \
-      LAZY_INSTANCE_INITIALIZER
-
-// e.g. "?fbclid=1234"
-DECLARE_LAZY_MATCHER(tracker_only_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+$");
-
-// e.g. "?fbclid=1234&foo=1"
-DECLARE_LAZY_MATCHER(tracker_first_matcher,
-                     "^(" + GetQueryStringTrackers() + ")=[^&]+&");
-
-// e.g. "?foo=1&fbclid=1234" or "?foo=1&fbclid=1234&bar=2"
-DECLARE_LAZY_MATCHER(tracker_appended_matcher,
-                     "&(" + GetQueryStringTrackers() + ")=[^&]+");
-
-#undef DECLARE_LAZY_MATCHER
+// Copies |query| into |new_query| in a single pass, dropping every
+// `tracker=value` parameter with a non-empty value. All other parameters,
+// including empty and malformed ones, are kept verbatim. Returns whether
+// anything was dropped.
+bool StripQueryStringTrackers(base::StringPiece query, std::string* new_query) {
+  const QueryStringTrackers& trackers = GetQueryStringTrackers();
+  bool stripped = false;
+  bool first = true;
+  new_query->clear();
+  new_query->reserve(query.size());
+  size_t start = 0;
+  while (true) {
+    const size_t end = query.find('&', start);
+    const base::StringPiece param = query.substr(
+        start, end == base::StringPiece::npos ? end : end - start);
+    const size_t equals = param.find('=');
+    if (equals != base::StringPiece::npos && equals + 1 < param.size() &&
+        trackers.count(param.substr(0, equals))) {
+      stripped = true;
+    } else {
+      if (!first)
+        new_query->push_back('&');
+      param.AppendToString(new_query);
+      first = false;
+    }
+    if (end == base::StringPiece::npos)
+      break;
+    start = end + 1;
+  }
+  return stripped;
+}
 
 void ApplyPotentialQueryStringFilter(const GURL& request_url,
                                      std::string* new_url_spec) {
   DCHECK(new_url_spec);
   SCOPED_UMA_HISTOGRAM_TIMER("Brave.SiteHacks.QueryFilter");
-  std::string new_query = request_url.query();
-  // Note: the ordering of these replacements is important.
-  const int replacement_count =
-      re2::RE2::GlobalReplace(&new_query, tracker_appended_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_first_matcher.Get(), "") +
-      re2::RE2::GlobalReplace(&new_query, tracker_only_matcher.Get(), "");
-
-  if (replacement_count > 0) {
+  std::string new_query;
+  if (StripQueryStringTrackers(request_url.query_piece(), &new_query)) {
     url::Replacements<char> replacements;
     if (new_query.empty()) {
       replacements.ClearQuery();
@@ -120,6 +125,7 @@ bool ApplyPotentialReferrerBlock(std::shared_ptr<BraveRequestInfo> ctx) {
 
 int OnBeforeURLRequest_SiteHacksWork(const ResponseCallback& next_callback,
                                      std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT0("browser", "OnBeforeURLRequest_SiteHacksWork");
   ApplyPotentialReferrerBlock(ctx);
   if (ctx->request_url.has_query()) {
     ApplyPotentialQueryStringFilter(ctx->request_url, &ctx->new_url_spec);
@@ -216,3 +216,35 @@ TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFiltered) {
     EXPECT_EQ(brave_request_info->new_url_spec, pair.second);
   }
 }
+
+TEST(BraveSiteHacksNetworkDelegateHelperTest, QueryStringFilteredIgnoresCase) {
+  auto brave_request_info = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://example.com/?FBCLID=1&foo=1&HsCtaTracking=2"));
+  int rc = brave::OnBeforeURLRequest_SiteHacksWork(ResponseCallback(),
+                                                   brave_request_info);
+  EXPECT_EQ(rc, net::OK);
+  EXPECT_EQ(brave_request_info->new_url_spec, "https://example.com/?foo=1");
+}
+
+// Compare against the Brave.SiteHacks.QueryFilter histogram recorded by
+// previous releases.
+TEST(BraveSiteHacksNetworkDelegateHelperTest,
+     DISABLED_QueryStringFilterBenchmark) {
+  const std::vector<std::pair<GURL, std::string>> urls(
+      {{GURL("https://example.com/path/file.html?foo=1&bar=2&baz=3#fragment"),
+        ""},
+       {GURL("https://example.com/?utm_source=a&utm_medium=b&fbclid=1234"),
+        "https://example.com/?utm_source=a&utm_medium=b"},
+       {GURL("https://example.com/?gclid=1&a=b&msclkid=2&c=d&__hsfp=3"),
+        "https://example.com/?a=b&c=d"}});
+  constexpr int kIterations = 100000;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const auto& pair : urls) {
+      auto brave_request_info =
+          std::make_shared<brave::BraveRequestInfo>(pair.first);
+      brave::OnBeforeURLRequest_SiteHacksWork(ResponseCallback(),
+                                              brave_request_info);
+      ASSERT_EQ(brave_request_info->new_url_spec, pair.second);
+    }
+  }
+}
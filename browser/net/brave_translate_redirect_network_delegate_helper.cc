@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 #include <vector>
+
+#include "base/trace_event/trace_event.h"
 #include "brave/common/translate_network_constants.h"
 #include "extensions/common/url_pattern.h"
 
@@ -57,6 +59,7 @@ bool IsTranslateGen204Request(const GURL& gurl) {
 int OnBeforeURLRequest_TranslateRedirectWork(
     const ResponseCallback& next_callback,
     std::shared_ptr<BraveRequestInfo> ctx) {
+  TRACE_EVENT0("browser", "OnBeforeURLRequest_TranslateRedirectWork");
   GURL::Replacements replacements;
 
   // Abort those gen204 requests triggered by translate element library.
@@ -8,25 +8,27 @@
 #include <memory>
 #include <string>
 
+#include "brave/browser/brave_shields/shields_settings_cache_factory.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
 #include "brave/components/brave_webtorrent/browser/buildflags/buildflags.h"
 #include "brave/components/brave_webtorrent/browser/webtorrent_util.h"
 #include "chrome/browser/content_settings/host_content_settings_map_factory.h"
 #include "chrome/browser/profiles/profile.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/isolation_info.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/resource_request_body.h"
 
 namespace brave {
 
-namespace {
-
-std::string GetUploadData(const network::ResourceRequest& request) {
+std::string GetUploadData(const network::ResourceRequestBody* request_body) {
   std::string upload_data;
-  if (!request.request_body) {
+  if (!request_body) {
     return {};
   }
-  const auto* elements = request.request_body->elements();
+  const auto* elements = request_body->elements();
   for (const network::DataElement& element : *elements) {
     if (element.type() == network::mojom::DataElementType::kBytes) {
       upload_data.append(element.bytes(), element.length());
@@ -36,8 +38,6 @@ std::string GetUploadData(const network::ResourceRequest& request) {
   return upload_data;
 }
 
-}  // namespace
-
 BraveRequestInfo::BraveRequestInfo() = default;
 
 BraveRequestInfo::BraveRequestInfo(const GURL& url) : request_url(url) {}
@@ -99,16 +99,24 @@ void BraveRequestInfo::FillCTX(const network::ResourceRequest& request,
                               .GetOrigin();
   }
 
-  Profile* profile = Profile::FromBrowserContext(browser_context);
-  auto* map = HostContentSettingsMapFactory::GetForProfile(profile);
-  ctx->allow_brave_shields =
-      brave_shields::GetBraveShieldsEnabled(map, ctx->tab_origin);
-  ctx->allow_ads = brave_shields::GetAdControlType(
-      map, ctx->tab_origin) == brave_shields::ControlType::ALLOW;
+  // Every request of a page shares the tab origin, so the settings are looked
+  // up once and then copied from the cache.
+  brave_shields::ShieldsSettings settings;
+  if (auto* cache = brave_shields::ShieldsSettingsCacheFactory::
+          GetForBrowserContext(browser_context)) {
+    settings = cache->Get(ctx->tab_origin);
+  } else {
+    Profile* profile = Profile::FromBrowserContext(browser_context);
+    settings = brave_shields::GetShieldsSettings(
+        HostContentSettingsMapFactory::GetForProfile(profile),
+        ctx->tab_origin);
+  }
+  ctx->allow_brave_shields = settings.allow_brave_shields;
+  ctx->allow_ads = settings.allow_ads;
   ctx->allow_http_upgradable_resource =
-      !brave_shields::GetHTTPSEverywhereEnabled(map, ctx->tab_origin);
-  ctx->allow_referrers = brave_shields::AllowReferrers(map, ctx->tab_origin);
-  ctx->upload_data = GetUploadData(request);
+      settings.allow_http_upgradable_resource;
+  ctx->allow_referrers = settings.allow_referrers;
+  ctx->request_body = request.request_body;
 }
 
 }  // namespace brave
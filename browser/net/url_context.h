@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/memory/ref_counted.h"
 #include "net/url_request/url_request.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 #include "url/gurl.h"
@@ -21,6 +22,7 @@ class BrowserContext;
 }
 
 namespace network {
+class ResourceRequestBody;
 struct ResourceRequest;
 }
 
@@ -100,7 +102,8 @@ struct BraveRequestInfo {
       static_cast<blink::mojom::ResourceType>(-1);
   blink::mojom::ResourceType resource_type = kInvalidResourceType;
 
-  std::string upload_data;
+  // Shared with the request rather than copied, see GetUploadData().
+  scoped_refptr<network::ResourceRequestBody> request_body;
 
   static void FillCTX(const network::ResourceRequest& request,
                       int render_process_id,
@@ -119,6 +122,10 @@ struct BraveRequestInfo {
   DISALLOW_COPY_AND_ASSIGN(BraveRequestInfo);
 };
 
+// Concatenates the bytes elements of |request_body|. Copying the body is
+// only worth it once a consumer knows it needs the data.
+std::string GetUploadData(const network::ResourceRequestBody* request_body);
+
 // ResponseListener
 using OnBeforeURLRequestCallback =
     base::Callback<int(const ResponseCallback& next_callback,
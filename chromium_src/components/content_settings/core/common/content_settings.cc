@@ -3,9 +3,31 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this file,
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "base/atomic_sequence_num.h"
+
 #define BRAVE_IS_RENDERER_CONTENT_SETTING \
   content_type == ContentSettingsType::AUTOPLAY ||
 
 #include "../../../../../../components/content_settings/core/common/content_settings.cc"
 
 #undef BRAVE_IS_RENDERER_CONTENT_SETTING
+
+namespace content_settings {
+
+namespace {
+
+base::AtomicSequenceNumber g_rules_generation;
+
+}  // namespace
+
+RulesGeneration::RulesGeneration() : value_(g_rules_generation.GetNext()) {}
+
+RulesGeneration::RulesGeneration(const RulesGeneration& other)
+    : RulesGeneration() {}
+
+RulesGeneration& RulesGeneration::operator=(const RulesGeneration& other) {
+  value_ = g_rules_generation.GetNext();
+  return *this;
+}
+
+}  // namespace content_settings
@@ -6,10 +6,30 @@
 #ifndef BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 #define BRAVE_CHROMIUM_SRC_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTINGS_H_
 
+namespace content_settings {
+
+// Takes a new value whenever the RendererContentSettingRules holding it are
+// created or assigned. The renderer replaces its rules in place when settings
+// change, so state derived from them uses this to tell that they changed.
+class RulesGeneration {
+ public:
+  RulesGeneration();
+  RulesGeneration(const RulesGeneration& other);
+  RulesGeneration& operator=(const RulesGeneration& other);
+
+  int value() const { return value_; }
+
+ private:
+  int value_;
+};
+
+}  // namespace content_settings
+
 #define BRAVE_CONTENT_SETTINGS_H                  \
   ContentSettingsForOneType autoplay_rules;       \
   ContentSettingsForOneType fingerprinting_rules; \
-  ContentSettingsForOneType brave_shields_rules;
+  ContentSettingsForOneType brave_shields_rules;  \
+  content_settings::RulesGeneration generation;
 
 #include "../../../../../../components/content_settings/core/common/content_settings.h"
 
@@ -5,6 +5,11 @@
 
 #include "third_party/blink/renderer/core/dom/document.h"
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+#include "base/numerics/safe_conversions.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "crypto/hmac.h"
@@ -12,6 +17,7 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/frame/local_dom_window.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
+#include "third_party/blink/renderer/platform/audio/vector_math.h"
 #include "third_party/blink/renderer/platform/bindings/script_state.h"
 #include "third_party/blink/renderer/platform/graphics/image_data_buffer.h"
 #include "third_party/blink/renderer/platform/graphics/static_bitmap_image.h"
@@ -19,6 +25,8 @@
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/network/network_utils.h"
 #include "third_party/blink/renderer/platform/supplementable.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
 
 namespace {
 
@@ -28,32 +36,116 @@ inline uint64_t lfsr_next(uint64_t v) {
   return ((v >> 1) | (((v << 62) ^ (v << 61)) & (~(~zero << 63) << 62)));
 }
 
-float Identity(float value, size_t index) {
-  return value;
+const double kMaxUInt64AsDouble = UINT64_MAX;
+
+// Pseudo-random float between 0 and 0.1.
+inline float PseudoRandomSample(uint64_t v) {
+  return (v / kMaxUInt64AsDouble) / 10;
 }
 
-float ConstantMultiplier(double fudge_factor, float value, size_t index) {
-  return value * fudge_factor;
+// Upper bound on the size of a perturbed canvas snapshot kept for reuse.
+const size_t kMaxCachedPerturbedImageBytes = 4 * 1024 * 1024;
+
+// Upper bound on the canvas bytes fed to the content hash.
+const size_t kMaxHashedCanvasBytes = 256 * 1024;
+
+// Returns a transparent image of |size|, or nullptr if it can't be allocated,
+// in which case callers refuse the readback.
+scoped_refptr<blink::StaticBitmapImage> MakeBlankImage(
+    const blink::IntSize& size) {
+  sk_sp<SkSurface> surface =
+      SkSurface::MakeRasterN32Premul(size.Width(), size.Height());
+  if (!surface)
+    return nullptr;
+  surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+  return blink::UnacceleratedStaticBitmapImage::Create(
+      surface->makeImageSnapshot());
 }
 
-float PseudoRandomSequence(uint64_t seed, float value, size_t index) {
-  static uint64_t v;
-  const double maxUInt64AsDouble = UINT64_MAX;
-  if (index == 0) {
-    // start of loop, reset to initial seed which was passed in and is based on
-    // the domain key
-    v = seed;
+// Returns the part of the RGBA |pixels| used to key the perturbation: all of
+// it for small canvases, otherwise evenly spaced rows up to
+// kMaxHashedCanvasBytes, so large canvases don't pay for hashing every pixel.
+std::string SampleCanvasContents(const uint8_t* pixels,
+                                 int width,
+                                 int height) {
+  const size_t row_bytes = 4 * static_cast<size_t>(width);
+  const size_t total_bytes = row_bytes * height;
+  const char* data = reinterpret_cast<const char*>(pixels);
+  if (total_bytes <= kMaxHashedCanvasBytes)
+    return std::string(data, total_bytes);
+
+  const size_t sampled_rows = std::max<size_t>(1, kMaxHashedCanvasBytes /
+                                                      row_bytes);
+  const size_t row_stride = std::max<size_t>(1, height / sampled_rows);
+  std::string sample;
+  sample.reserve(sampled_rows * row_bytes);
+  for (size_t row = 0; row < static_cast<size_t>(height) &&
+                       sample.size() + row_bytes <= kMaxHashedCanvasBytes;
+       row += row_stride) {
+    sample.append(data + row * row_bytes, row_bytes);
   }
-  // get next value in PRNG sequence
-  v = lfsr_next(v);
-  // return pseudo-random float between 0 and 0.1
-  return (v / maxUInt64AsDouble) / 10;
+  return sample;
 }
 
 }  // namespace
 
 namespace brave {
 
+AudioFarbler::AudioFarbler() = default;
+
+// static
+AudioFarbler AudioFarbler::ConstantMultiplier(float fudge_factor) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kConstantMultiplier;
+  farbler.fudge_factor_ = fudge_factor;
+  return farbler;
+}
+
+// static
+AudioFarbler AudioFarbler::PseudoRandomSequence(uint64_t seed) {
+  AudioFarbler farbler;
+  farbler.mode_ = Mode::kPseudoRandomSequence;
+  farbler.seed_ = seed;
+  return farbler;
+}
+
+void AudioFarbler::FarbleSamples(float* samples, size_t count) const {
+  switch (mode_) {
+    case Mode::kIdentity:
+      break;
+    case Mode::kConstantMultiplier:
+      blink::vector_math::Vsmul(samples, 1, &fudge_factor_, samples, 1,
+                                base::checked_cast<uint32_t>(count));
+      break;
+    case Mode::kPseudoRandomSequence: {
+      // The LFSR is inherently serial, but filling the buffer directly keeps
+      // the loop free of calls.
+      uint64_t v = seed_;
+      for (size_t i = 0; i < count; ++i) {
+        v = lfsr_next(v);
+        samples[i] = PseudoRandomSample(v);
+      }
+      break;
+    }
+  }
+}
+
+float AudioFarbler::FarbleSample(float value, size_t index) {
+  switch (mode_) {
+    case Mode::kIdentity:
+      return value;
+    case Mode::kConstantMultiplier:
+      return value * fudge_factor_;
+    case Mode::kPseudoRandomSequence:
+      if (index == 0)
+        state_ = seed_;
+      state_ = lfsr_next(state_);
+      return PseudoRandomSample(state_);
+  }
+  NOTREACHED();
+  return value;
+}
+
 const char kBraveSessionToken[] = "brave_session_token";
 const char BraveSessionCache::kSupplementName[] = "BraveSessionCache";
 
@@ -99,28 +191,41 @@ BraveSessionCache& BraveSessionCache::From(Document& document) {
   return *cache;
 }
 
-AudioFarblingCallback BraveSessionCache::GetAudioFarblingCallback(
-    blink::LocalFrame* frame) {
-  if (farbling_enabled_ && frame && frame->GetContentSettingsClient()) {
-    switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
-      case BraveFarblingLevel::OFF: {
-        break;
-      }
-      case BraveFarblingLevel::BALANCED: {
-        const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
-        const double maxUInt64AsDouble = UINT64_MAX;
-        double fudge_factor = 0.99 + ((*fudge / maxUInt64AsDouble) / 100);
-        VLOG(1) << "audio fudge factor (based on session token) = "
-                << fudge_factor;
-        return base::BindRepeating(&ConstantMultiplier, fudge_factor);
-      }
-      case BraveFarblingLevel::MAXIMUM: {
-        uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
-        return base::BindRepeating(&PseudoRandomSequence, seed);
-      }
+BraveFarblingLevel BraveSessionCache::GetBraveFarblingLevel() {
+  if (farbling_level_)
+    return *farbling_level_;
+  blink::LocalFrame* frame = GetSupplementable()->GetFrame();
+  if (!frame || !frame->GetContentSettingsClient())
+    return BraveFarblingLevel::OFF;
+  farbling_level_ = frame->GetContentSettingsClient()->GetBraveFarblingLevel();
+  return *farbling_level_;
+}
+
+AudioFarbler BraveSessionCache::GetAudioFarbler(blink::LocalFrame* frame) {
+  if (!farbling_enabled_ || !frame || !frame->GetContentSettingsClient())
+    return AudioFarbler();
+  if (audio_farbler_)
+    return *audio_farbler_;
+  switch (GetBraveFarblingLevel()) {
+    case BraveFarblingLevel::OFF: {
+      audio_farbler_ = AudioFarbler();
+      break;
+    }
+    case BraveFarblingLevel::BALANCED: {
+      const uint64_t* fudge = reinterpret_cast<const uint64_t*>(domain_key_);
+      double fudge_factor = 0.99 + ((*fudge / kMaxUInt64AsDouble) / 100);
+      VLOG(1) << "audio fudge factor (based on session token) = "
+              << fudge_factor;
+      audio_farbler_ = AudioFarbler::ConstantMultiplier(fudge_factor);
+      break;
+    }
+    case BraveFarblingLevel::MAXIMUM: {
+      uint64_t seed = *reinterpret_cast<uint64_t*>(domain_key_);
+      audio_farbler_ = AudioFarbler::PseudoRandomSequence(seed);
+      break;
     }
   }
-  return base::BindRepeating(&Identity);
+  return *audio_farbler_;
 }
 
 scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
@@ -129,7 +234,7 @@ scoped_refptr<blink::StaticBitmapImage> BraveSessionCache::PerturbPixels(
   if (!farbling_enabled_ || !frame || !frame->GetContentSettingsClient()) {
     return image_bitmap;
   }
-  switch (frame->GetContentSettingsClient()->GetBraveFarblingLevel()) {
+  switch (GetBraveFarblingLevel()) {
     case BraveFarblingLevel::OFF:
       break;
     case BraveFarblingLevel::BALANCED:
@@ -149,30 +254,48 @@ BraveSessionCache::PerturbPixelsInternal(
   DCHECK(image_bitmap);
   if (image_bitmap->IsNull())
     return image_bitmap;
+  // Canvases keep returning the same snapshot until they are drawn to again,
+  // so repeated readbacks of an unchanged canvas reuse the last result.
+  const sk_sp<SkImage> sk_image =
+      image_bitmap->PaintImageForCurrentFrame().GetSkImage();
+  const uint32_t image_id = sk_image ? sk_image->uniqueID() : 0;
+  const bool is_last_perturbed_image =
+      image_id && image_id == last_perturbed_image_id_;
+  if (is_last_perturbed_image && last_perturbed_image_)
+    return last_perturbed_image_;
   // convert to an ImageDataBuffer to normalize the pixel data to RGBA, 4 bytes
   // per pixel
   std::unique_ptr<blink::ImageDataBuffer> data_buffer =
       blink::ImageDataBuffer::Create(image_bitmap);
+  // The pixels can't be perturbed, so they must not be returned as they are.
+  if (!data_buffer)
+    return MakeBlankImage(image_bitmap->Size());
   uint8_t* pixels = const_cast<uint8_t*>(data_buffer->Pixels());
-  // This needs to be type size_t because we pass it to base::StringPiece
-  // later for content hashing. This is safe because the maximum canvas
-  // dimensions are less than SIZE_T_MAX. (Width and height are each
-  // limited to 32,767 pixels.)
+  // This is safe because the maximum canvas dimensions are less than
+  // SIZE_T_MAX. (Width and height are each limited to 32,767 pixels.)
   const size_t pixel_count = data_buffer->Width() * data_buffer->Height();
+  if (!pixel_count)
+    return image_bitmap;
   // choose which channel (R, G, or B) to perturb
   const uint8_t* first_byte = reinterpret_cast<const uint8_t*>(domain_key_);
   uint8_t channel = *first_byte % 3;
   // calculate initial seed to find first pixel to perturb, based on session
   // key, domain key, and canvas contents
-  crypto::HMAC h(crypto::HMAC::SHA256);
-  uint64_t session_plus_domain_key =
-      session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
-  CHECK(h.Init(reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
-               sizeof session_plus_domain_key));
   uint8_t canvas_key[32];
-  CHECK(h.Sign(
-      base::StringPiece(reinterpret_cast<const char*>(pixels), pixel_count),
-      canvas_key, sizeof canvas_key));
+  if (is_last_perturbed_image) {
+    std::copy(std::begin(last_perturbed_canvas_key_),
+              std::end(last_perturbed_canvas_key_), std::begin(canvas_key));
+  } else {
+    crypto::HMAC h(crypto::HMAC::SHA256);
+    uint64_t session_plus_domain_key =
+        session_key_ ^ *reinterpret_cast<uint64_t*>(domain_key_);
+    CHECK(h.Init(
+        reinterpret_cast<const unsigned char*>(&session_plus_domain_key),
+        sizeof session_plus_domain_key));
+    CHECK(h.Sign(SampleCanvasContents(pixels, data_buffer->Width(),
+                                      data_buffer->Height()),
+                 canvas_key, sizeof canvas_key));
+  }
   uint64_t v = *reinterpret_cast<uint64_t*>(canvas_key);
   uint64_t pixel_index;
   // iterate through 32-byte canvas key and use each bit to determine how to
@@ -187,10 +310,19 @@ BraveSessionCache::PerturbPixelsInternal(
       v = lfsr_next(v);
     }
   }
-  // convert back to a StaticBitmapImage to return to the caller
+  // wrap the perturbed pixels, without copying them, to return to the caller
   scoped_refptr<blink::StaticBitmapImage> perturbed_bitmap =
       blink::UnacceleratedStaticBitmapImage::Create(
           data_buffer->RetainedImage());
+  last_perturbed_image_id_ = image_id;
+  std::copy(std::begin(canvas_key), std::end(canvas_key),
+            std::begin(last_perturbed_canvas_key_));
+  // Holding on to the pixels of a large canvas for the rest of the document's
+  // lifetime costs more than perturbing it again.
+  if (4 * pixel_count <= kMaxCachedPerturbedImageBytes)
+    last_perturbed_image_ = perturbed_bitmap;
+  else
+    last_perturbed_image_ = nullptr;
   return perturbed_bitmap;
 }
 
@@ -10,7 +10,8 @@
 
 #include <random>
 
-#include "base/callback.h"
+#include "base/optional.h"
+#include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 
 using blink::Document;
 using blink::GarbageCollected;
@@ -27,7 +28,34 @@ class StaticBitmapImage;
 
 namespace brave {
 
-typedef base::RepeatingCallback<float(float, size_t)> AudioFarblingCallback;
+// Farbles audio samples for a document. Chosen once per document so that
+// hooks farble whole buffers without an indirect call per sample.
+class CORE_EXPORT AudioFarbler {
+ public:
+  // Leaves samples untouched.
+  AudioFarbler();
+  static AudioFarbler ConstantMultiplier(float fudge_factor);
+  static AudioFarbler PseudoRandomSequence(uint64_t seed);
+
+  bool IsIdentity() const { return mode_ == Mode::kIdentity; }
+
+  // Farbles |count| samples of |samples| in place, starting a new
+  // sequence at samples[0].
+  void FarbleSamples(float* samples, size_t count) const;
+
+  // Farbles a single sample, for hooks that farble intermediate values
+  // one at a time. Index 0 starts a new sequence.
+  float FarbleSample(float value, size_t index);
+
+ private:
+  enum class Mode { kIdentity, kConstantMultiplier, kPseudoRandomSequence };
+
+  Mode mode_ = Mode::kIdentity;
+  float fudge_factor_ = 1;
+  uint64_t seed_ = 0;
+  // State of the per-sample sequence.
+  uint64_t state_ = 0;
+};
 
 class CORE_EXPORT BraveSessionCache final
     : public GarbageCollected<BraveSessionCache>,
@@ -42,7 +70,15 @@ class CORE_EXPORT BraveSessionCache final
 
   static BraveSessionCache& From(Document&);
 
-  AudioFarblingCallback GetAudioFarblingCallback(blink::LocalFrame* frame);
+  // The farbling level of the document, resolved from the content settings
+  // client on first use and kept for the lifetime of the document so that
+  // hot APIs (e.g. WebGL and canvas calls) only branch on the cached value.
+  BraveFarblingLevel GetBraveFarblingLevel();
+  bool AllowFingerprinting() {
+    return GetBraveFarblingLevel() != BraveFarblingLevel::MAXIMUM;
+  }
+
+  AudioFarbler GetAudioFarbler(blink::LocalFrame* frame);
   scoped_refptr<blink::StaticBitmapImage> PerturbPixels(
       blink::LocalFrame* frame,
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
@@ -53,6 +89,14 @@ class CORE_EXPORT BraveSessionCache final
   bool farbling_enabled_;
   uint64_t session_key_;
   uint8_t domain_key_[32];
+  base::Optional<BraveFarblingLevel> farbling_level_;
+  base::Optional<AudioFarbler> audio_farbler_;
+  // The last perturbed canvas snapshot, keyed by the SkImage it came from.
+  // Only small snapshots keep their pixels; for larger ones just the
+  // perturbation key is kept so that re-hashing the contents is skipped.
+  uint32_t last_perturbed_image_id_ = 0;
+  uint8_t last_perturbed_canvas_key_[32];
+  scoped_refptr<blink::StaticBitmapImage> last_perturbed_image_;
 
   scoped_refptr<blink::StaticBitmapImage> PerturbPixelsInternal(
       scoped_refptr<blink::StaticBitmapImage> image_bitmap);
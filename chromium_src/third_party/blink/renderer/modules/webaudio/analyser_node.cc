@@ -11,10 +11,9 @@
   if (ExecutionContext* context = node.GetExecutionContext()) {           \
     if (LocalDOMWindow* local_dom_window =                                \
             DynamicTo<LocalDOMWindow>(context)) {                         \
-      analyser_.audio_farbling_callback_ =                                \
+      analyser_.audio_farbler_ =                                          \
           brave::BraveSessionCache::From(*(local_dom_window->document())) \
-              .GetAudioFarblingCallback(                                  \
-                  local_dom_window->document()->GetFrame());              \
+              .GetAudioFarbler(local_dom_window->document()->GetFrame()); \
     }                                                                     \
   }
 
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
@@ -548,6 +549,11 @@ void AdsServiceImpl::Shutdown() {
 
   idle_poll_timer_.Stop();
 
+  if (is_initialized_ && connected()) {
+    // Writes client state changes which are still waiting to be saved
+    bat_ads_->Shutdown(base::DoNothing());
+  }
+
   bat_ads_.reset();
   bat_ads_client_receiver_.reset();
   bat_ads_service_.reset();
@@ -690,6 +696,8 @@ void AdsServiceImpl::OnShutdownBatAds(
     return;
   }
 
+  // Ads have already been shut down, so don't shut them down again
+  is_initialized_ = false;
   Shutdown();
 
   VLOG(1) << "Successfully shutdown ads";
@@ -797,6 +805,8 @@ void AdsServiceImpl::OnShutdownAndResetBatAds(
     return;
   }
 
+  // Ads have already been shut down, so don't shut them down again
+  is_initialized_ = false;
   Shutdown();
 
   VLOG(1) << "Successfully shutdown ads";
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 
 namespace brave_component_updater {
 
@@ -41,6 +42,33 @@ LoadDATFileDataResult<T> LoadDATFileData(
       std::move(client), std::move(buffer));
 }
 
+// Maps |file_path| read-only. Returns nullptr if the file is missing, empty
+// or can't be mapped.
+std::unique_ptr<base::MemoryMappedFile> MapDATFile(
+    const base::FilePath& file_path);
+
+// Like LoadDATFileData, but deserializes straight from the mapped file pages
+// instead of first copying the whole file into a heap buffer, which keeps the
+// several-megabyte DAT files out of peak RSS while engines load. Only for
+// deserializers that copy what they need, since the mapping is released
+// before returning; must run where blocking is allowed.
+template<typename T>
+std::unique_ptr<T> DeserializeDATFile(const base::FilePath& dat_file_path) {
+  std::unique_ptr<base::MemoryMappedFile> mapping = MapDATFile(dat_file_path);
+  if (!mapping)
+    return nullptr;
+
+  auto client = std::make_unique<T>();
+  // The deserializers take a non-const pointer but don't write to their
+  // input, so the read-only mapping can be handed over directly.
+  if (!client->deserialize(
+          const_cast<char*>(reinterpret_cast<const char*>(mapping->data())),
+          mapping->length()))
+    return nullptr;
+
+  return client;
+}
+
 
 }  // namespace brave_component_updater
 
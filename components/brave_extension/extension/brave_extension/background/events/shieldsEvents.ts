@@ -6,8 +6,10 @@ import actions from '../actions/shieldsPanelActions'
 import { BlockDetails } from '../../types/actions/shieldsPanelActions'
 
 if (chrome.braveShields) {
-  chrome.braveShields.onBlocked.addListener((detail: BlockDetails) => {
-    actions.resourceBlocked(detail)
+  chrome.braveShields.onBlocked.addListener((details: BlockDetails[]) => {
+    details.forEach((detail: BlockDetails) => {
+      actions.resourceBlocked(detail)
+    })
   })
 } else {
   console.log('chrome.braveShields not enabled')
@@ -13,8 +13,10 @@
 #include "brave/components/brave_perf_predictor/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/ui/browser.h"
+#include "chrome/browser/ui/tabs/tab_strip_model.h"
 #include "chrome/test/base/in_process_browser_test.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "components/prefs/pref_service.h"
@@ -33,6 +35,12 @@ uint64_t getProfileBandwidthSaved(Browser* browser) {
 }
 
 uint64_t getProfileAdsBlocked(Browser* browser) {
+  // Blocked counters are buffered per tab, so flush them before reading prefs.
+  brave_shields::BraveShieldsWebContentsObserver* observer =
+      brave_shields::BraveShieldsWebContentsObserver::FromWebContents(
+          browser->tab_strip_model()->GetActiveWebContents());
+  if (observer)
+    observer->FlushStats();
   return browser->profile()->GetPrefs()->GetUint64(
       kAdsBlocked);
 }
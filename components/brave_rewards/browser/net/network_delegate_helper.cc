@@ -7,8 +7,10 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/task/post_task.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/brave_rewards/browser/rewards_service.h"
 #include "brave/browser/brave_rewards/rewards_service_factory.h"
 #include "chrome/browser/profiles/profile.h"
@@ -74,17 +76,23 @@ void DispatchOnUI(
 int OnBeforeURLRequest(
   const brave::ResponseCallback& next_callback,
   std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-
-  if (IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
-    if (!ctx->upload_data.empty()) {
-      DispatchOnUI(ctx->upload_data,
-                   ctx->request_url,
-                   ctx->tab_url,
-                   ctx->referrer.spec(),
-                   ctx->render_process_id,
-                   ctx->render_frame_id,
-                   ctx->frame_tree_node_id);
+  TRACE_EVENT0("browser", "brave_rewards::OnBeforeURLRequest");
+
+  if (ctx->request_body &&
+      IsMediaLink(ctx->request_url, ctx->tab_origin, ctx->referrer)) {
+    // The body is only copied out of the request once it is known to be
+    // needed, and this runs off the UI thread.
+    std::string upload_data = brave::GetUploadData(ctx->request_body.get());
+    if (!upload_data.empty()) {
+      base::PostTask(FROM_HERE, {content::BrowserThread::UI},
+                     base::BindOnce(&DispatchOnUI,
+                                    std::move(upload_data),
+                                    ctx->request_url,
+                                    ctx->tab_url,
+                                    ctx->referrer.spec(),
+                                    ctx->render_process_id,
+                                    ctx->render_frame_id,
+                                    ctx->frame_tree_node_id));
     }
   }
 
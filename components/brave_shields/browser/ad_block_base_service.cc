@@ -11,8 +11,9 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
-#include "base/json/json_reader.h"
+#include "base/files/file_util.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -20,97 +21,66 @@
 #include "brave/browser/net/url_context.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
-#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
-#include "url/origin.h"
 
 using brave_component_updater::BraveComponent;
-using content::BrowserThread;
-using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
 
 namespace {
 
-std::string ResourceTypeToString(blink::mojom::ResourceType resource_type) {
-  std::string filter_option = "";
-  switch (resource_type) {
-    // top level page
-    case blink::mojom::ResourceType::kMainFrame:
-      filter_option = "main_frame";
-      break;
-    // frame or iframe
-    case blink::mojom::ResourceType::kSubFrame:
-      filter_option = "sub_frame";
-      break;
-    // a CSS stylesheet
-    case blink::mojom::ResourceType::kStylesheet:
-      filter_option = "stylesheet";
-      break;
-    // an external script
-    case blink::mojom::ResourceType::kScript:
-      filter_option = "script";
-      break;
-    // an image (jpg/gif/png/etc)
-    case blink::mojom::ResourceType::kFavicon:
-    case blink::mojom::ResourceType::kImage:
-      filter_option = "image";
-      break;
-    // a font
-    case blink::mojom::ResourceType::kFontResource:
-      filter_option = "font";
-      break;
-    // an "other" subresource.
-    case blink::mojom::ResourceType::kSubResource:
-      filter_option = "other";
-      break;
-    // an object (or embed) tag for a plugin.
-    case blink::mojom::ResourceType::kObject:
-      filter_option = "object";
-      break;
-    // a media resource.
-    case blink::mojom::ResourceType::kMedia:
-      filter_option = "media";
-      break;
-    // a XMLHttpRequest
-    case blink::mojom::ResourceType::kXhr:
-      filter_option = "xhr";
-      break;
-    // a ping request for <a ping>/sendBeacon.
-    case blink::mojom::ResourceType::kPing:
-      filter_option = "ping";
-      break;
-    // the main resource of a dedicated worker.
-    case blink::mojom::ResourceType::kWorker:
-    // the main resource of a shared worker.
-    case blink::mojom::ResourceType::kSharedWorker:
-    // an explicitly requested prefetch
-    case blink::mojom::ResourceType::kPrefetch:
-    // the main resource of a service worker.
-    case blink::mojom::ResourceType::kServiceWorker:
-    // a report of Content Security Policy violations.
-    case blink::mojom::ResourceType::kCspReport:
-    // a resource that a plugin requested.
-    case blink::mojom::ResourceType::kPluginResource:
-    default:
-      break;
+std::unique_ptr<adblock::Engine> CreateEngineFromRules(
+    const std::string& rules) {
+  return std::make_unique<adblock::Engine>(rules);
+}
+
+AdBlockBaseService::DATFileLoadResult LoadEngineFromDATFile(
+    const base::FilePath& dat_file_path) {
+  base::File::Info file_info;
+  if (!base::GetFileInfo(dat_file_path, &file_info))
+    return {};
+  return {brave_component_updater::DeserializeDATFile<adblock::Engine>(
+              dat_file_path),
+          file_info};
+}
+
+// Rebuilds only from the same DAT file the current engine was loaded from.
+// A component update may have replaced it in the meantime, and the newer
+// list is applied by its own update instead.
+std::unique_ptr<adblock::Engine> CreateEngineFromDATFile(
+    const base::FilePath& dat_file_path,
+    const base::File::Info& loaded_file_info) {
+  base::File::Info file_info;
+  if (!base::GetFileInfo(dat_file_path, &file_info) ||
+      file_info.size != loaded_file_info.size ||
+      file_info.last_modified != loaded_file_info.last_modified) {
+    LOG(ERROR) << "Ad block data changed since it was loaded "
+               << dat_file_path;
+    return nullptr;
   }
-  return filter_option;
+  return brave_component_updater::DeserializeDATFile<adblock::Engine>(
+      dat_file_path);
 }
 
 }  // namespace
 
-namespace brave_shields {
-
 AdBlockBaseService::AdBlockBaseService(BraveComponent::Delegate* delegate)
     : BaseBraveShieldsService(delegate),
-      ad_block_client_(new adblock::Engine()),
+      engine_(base::MakeRefCounted<AdBlockEngine>(
+          std::make_unique<adblock::Engine>())),
       weak_factory_(this) {}
 
 AdBlockBaseService::~AdBlockBaseService() {
-  GetTaskRunner()->DeleteSoon(FROM_HERE, ad_block_client_.release());
+}
+
+scoped_refptr<AdBlockEngine> AdBlockBaseService::GetEngine() {
+  base::AutoLock lock(engine_lock_);
+  return engine_;
 }
 
 bool AdBlockBaseService::ShouldStartRequest(
@@ -120,133 +90,155 @@ bool AdBlockBaseService::ShouldStartRequest(
     bool* did_match_exception,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-
-  // Determine third-party here so the library doesn't need to figure it out.
-  // CreateFromNormalizedTuple is needed because SameDomainOrHost needs
-  // a URL or origin and not a string to a host name.
-  bool is_third_party = !SameDomainOrHost(
-      url,
-      url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
-      INCLUDE_PRIVATE_REGISTRIES);
-  bool explicit_cancel;
-  bool saved_from_exception;
-  if (ad_block_client_->matches(
-          url.spec(), url.host(), tab_host, is_third_party,
-          ResourceTypeToString(resource_type), &explicit_cancel,
-          &saved_from_exception, mock_data_url)) {
-    if (cancel_request_explicitly) {
-      *cancel_request_explicitly = explicit_cancel;
-    }
-    // We'd only possibly match an exception filter if we're returning true.
-    if (did_match_exception) {
-      *did_match_exception = false;
-    }
-    // LOG(ERROR) << "AdBlockBaseService::ShouldStartRequest(), host: "
-    //  << tab_host
-    //  << ", resource type: " << resource_type
-    //  << ", url.spec(): " << url.spec();
-    return false;
-  }
-
-  if (did_match_exception) {
-    *did_match_exception = saved_from_exception;
-  }
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            did_match_exception, cancel_request_explicitly,
+                            mock_data_url);
+}
 
-  return true;
+bool AdBlockBaseService::ShouldStartRequest(const AdBlockRequest& request,
+                                            bool* did_match_exception,
+                                            bool* cancel_request_explicitly,
+                                            std::string* mock_data_url) {
+  return GetEngine()->ShouldStartRequest(request, did_match_exception,
+                                         cancel_request_explicitly,
+                                         mock_data_url);
 }
 
 void AdBlockBaseService::EnableTag(const std::string& tag, bool enabled) {
-  if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
+  if (!GetTaskRunner()->RunsTasksInCurrentSequence()) {
     GetTaskRunner()->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockBaseService::EnableTag,
                                   base::Unretained(this), tag, enabled));
     return;
   }
 
+  std::vector<std::string>::iterator it =
+      std::find(tags_.begin(), tags_.end(), tag);
+  if (enabled == (it != tags_.end()))
+    return;
+
   if (enabled) {
-    ad_block_client_->addTag(tag);
     tags_.push_back(tag);
   } else {
-    ad_block_client_->removeTag(tag);
-    std::vector<std::string>::iterator it =
-        std::find(tags_.begin(), tags_.end(), tag);
-    if (it != tags_.end()) {
-      tags_.erase(it);
-    }
+    tags_.erase(it);
   }
+  ScheduleRebuildAdBlockClient();
 }
 
 void AdBlockBaseService::AddResources(const std::string& resources) {
-  if (BrowserThread::CurrentlyOn(BrowserThread::UI)) {
+  if (!GetTaskRunner()->RunsTasksInCurrentSequence()) {
     GetTaskRunner()->PostTask(
         FROM_HERE, base::BindOnce(&AdBlockBaseService::AddResources,
                                   base::Unretained(this), resources));
     return;
   }
 
-  ad_block_client_->addResources(resources);
+  if (resources_ == resources)
+    return;
   resources_ = resources;
+  ScheduleRebuildAdBlockClient();
 }
 
 bool AdBlockBaseService::TagExists(const std::string& tag) {
   return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
 }
 
-base::Optional<base::Value> AdBlockBaseService::UrlCosmeticResources(
+base::Optional<CosmeticResources> AdBlockBaseService::UrlCosmeticResources(
         const std::string& url) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(ad_block_client_->urlCosmeticResources(url));
+  return GetEngine()->UrlCosmeticResources(url);
 }
 
-base::Optional<base::Value> AdBlockBaseService::HiddenClassIdSelectors(
+std::vector<std::string> AdBlockBaseService::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
-  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  return base::JSONReader::Read(
-      ad_block_client_->hiddenClassIdSelectors(classes, ids, exceptions));
+  return GetEngine()->HiddenClassIdSelectors(classes, ids, exceptions);
 }
 
 void AdBlockBaseService::GetDATFileData(const base::FilePath& dat_file_path) {
   base::PostTaskAndReplyWithResult(
       FROM_HERE, {base::ThreadPool(), base::MayBlock()},
-      base::BindOnce(&brave_component_updater::LoadDATFileData<adblock::Engine>,
-                     dat_file_path),
+      base::BindOnce(&LoadEngineFromDATFile, dat_file_path),
       base::BindOnce(&AdBlockBaseService::OnGetDATFileData,
-                     weak_factory_.GetWeakPtr()));
+                     weak_factory_.GetWeakPtr(), dat_file_path));
 }
 
-void AdBlockBaseService::OnGetDATFileData(GetDATFileDataResult result) {
-  if (result.second.empty()) {
-    LOG(ERROR) << "Could not obtain ad block data";
-    return;
-  }
-  if (!result.first.get()) {
-    LOG(ERROR) << "Failed to deserialize ad block data";
+void AdBlockBaseService::OnGetDATFileData(const base::FilePath& dat_file_path,
+                                          DATFileLoadResult result) {
+  if (!result.first) {
+    LOG(ERROR) << "Failed to load ad block data";
     return;
   }
   GetTaskRunner()->PostTask(
-      FROM_HERE, base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
-                                base::Unretained(this),
-                                std::move(result.first)));
+      FROM_HERE,
+      base::BindOnce(&AdBlockBaseService::UpdateAdBlockClient,
+                     base::Unretained(this), std::move(result.first),
+                     base::BindRepeating(&CreateEngineFromDATFile,
+                                         dat_file_path, result.second)));
+}
+
+void AdBlockBaseService::UpdateAdBlockClientFromRules(
+    const std::string& rules) {
+  UpdateAdBlockClient(CreateEngineFromRules(rules),
+                      base::BindRepeating(&CreateEngineFromRules, rules));
 }
 
 void AdBlockBaseService::UpdateAdBlockClient(
-    std::unique_ptr<adblock::Engine> ad_block_client) {
+    std::unique_ptr<adblock::Engine> ad_block_client,
+    EngineFactory engine_factory) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_ = std::move(ad_block_client);
-  AddKnownTagsToAdBlockInstance();
-  AddKnownResourcesToAdBlockInstance();
+  engine_factory_ = std::move(engine_factory);
+  // The new engine picks up the current tags and resources, so a scheduled
+  // rebuild is no longer needed.
+  rebuild_pending_ = false;
+  PublishAdBlockClient(std::move(ad_block_client));
 }
 
-void AdBlockBaseService::AddKnownTagsToAdBlockInstance() {
-  std::for_each(tags_.begin(), tags_.end(),
-                [&](const std::string tag) { ad_block_client_->addTag(tag); });
+void AdBlockBaseService::ScheduleRebuildAdBlockClient() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  if (rebuild_pending_)
+    return;
+  rebuild_pending_ = true;
+  GetTaskRunner()->PostTask(
+      FROM_HERE, base::BindOnce(&AdBlockBaseService::RebuildAdBlockClient,
+                                base::Unretained(this)));
 }
 
-void AdBlockBaseService::AddKnownResourcesToAdBlockInstance() {
-  ad_block_client_->addResources(resources_);
+void AdBlockBaseService::RebuildAdBlockClient() {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  if (!rebuild_pending_)
+    return;
+  rebuild_pending_ = false;
+
+  // Nothing has been loaded yet, tags and resources will be applied once the
+  // first engine arrives.
+  if (!engine_factory_)
+    return;
+
+  std::unique_ptr<adblock::Engine> ad_block_client = engine_factory_.Run();
+  if (!ad_block_client) {
+    LOG(ERROR) << "Failed to rebuild ad block engine";
+    return;
+  }
+  PublishAdBlockClient(std::move(ad_block_client));
+}
+
+void AdBlockBaseService::PublishAdBlockClient(
+    std::unique_ptr<adblock::Engine> ad_block_client) {
+  std::for_each(tags_.begin(), tags_.end(), [&](const std::string& tag) {
+    ad_block_client->addTag(tag);
+  });
+  ad_block_client->addResources(resources_);
+
+  auto engine =
+      base::MakeRefCounted<AdBlockEngine>(std::move(ad_block_client));
+  {
+    base::AutoLock lock(engine_lock_);
+    engine_.swap(engine);
+  }
+  // The previous engine is released outside of the lock, and is destroyed
+  // once in-flight matches drop their references.
+  AdBlockDecisionCache::GetInstance()->Invalidate();
 }
 
 bool AdBlockBaseService::Init() {
@@ -258,12 +250,12 @@ void AdBlockBaseService::ResetForTest(const std::string& rules,
   // This is temporary until adblock-rust supports incrementally adding
   // filter rules to an existing instance. At which point the hack below
   // will dissapear.
-  ad_block_client_.reset(new adblock::Engine(rules));
-  AddKnownTagsToAdBlockInstance();
   if (!resources.empty()) {
     resources_ = resources;
   }
-  AddKnownResourcesToAdBlockInstance();
+  engine_factory_ = base::BindRepeating(&CreateEngineFromRules, rules);
+  rebuild_pending_ = false;
+  PublishAdBlockClient(CreateEngineFromRules(rules));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -13,11 +13,19 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/files/file.h"
 #include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/optional.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/lock.h"
 #include "base/values.h"
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
 #include "brave/components/brave_component_updater/browser/dat_file_util.h"
 #include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
 
@@ -32,10 +40,15 @@ namespace brave_shields {
 
 // The base class of the brave shields service in charge of ad-block
 // checking and init.
+//
+// Engines are configured on the service's task runner and then published as
+// an immutable AdBlockEngine, so requests can be matched from any thread.
 class AdBlockBaseService : public BaseBraveShieldsService {
  public:
-  using GetDATFileDataResult =
-      brave_component_updater::LoadDATFileDataResult<adblock::Engine>;
+  // The engine deserialized from a DAT file, and the file's info at the time
+  // so rebuilds can tell whether it was replaced since.
+  using DATFileLoadResult =
+      std::pair<std::unique_ptr<adblock::Engine>, base::File::Info>;
 
   explicit AdBlockBaseService(BraveComponent::Delegate* delegate);
   ~AdBlockBaseService() override;
@@ -46,36 +59,60 @@ class AdBlockBaseService : public BaseBraveShieldsService {
                           bool* did_match_exception,
                           bool* cancel_request_explicitly,
                           std::string* mock_data_url) override;
+  // Same as above, but reuses request features that were already computed
+  // for another engine.
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url);
   void AddResources(const std::string& resources);
   void EnableTag(const std::string& tag, bool enabled);
   bool TagExists(const std::string& tag);
 
-  base::Optional<base::Value> UrlCosmeticResources(
+  base::Optional<CosmeticResources> UrlCosmeticResources(
           const std::string& url);
-  base::Optional<base::Value> HiddenClassIdSelectors(
+  std::vector<std::string> HiddenClassIdSelectors(
           const std::vector<std::string>& classes,
           const std::vector<std::string>& ids,
           const std::vector<std::string>& exceptions);
 
+  // Returns the currently published engine. Safe to call from any thread.
+  scoped_refptr<AdBlockEngine> GetEngine();
+
  protected:
   friend class ::AdBlockServiceTest;
+  // Creates a fresh, unconfigured engine from the service's source data.
+  using EngineFactory =
+      base::RepeatingCallback<std::unique_ptr<adblock::Engine>()>;
+
   bool Init() override;
 
   void GetDATFileData(const base::FilePath& dat_file_path);
-  void AddKnownTagsToAdBlockInstance();
-  void AddKnownResourcesToAdBlockInstance();
-  void ResetForTest(const std::string& rules, const std::string& resources);
-
-  std::unique_ptr<adblock::Engine> ad_block_client_;
+  void UpdateAdBlockClientFromRules(const std::string& rules);
+  virtual void ResetForTest(const std::string& rules,
+                            const std::string& resources);
 
  private:
-  void UpdateAdBlockClient(
-      std::unique_ptr<adblock::Engine> ad_block_client);
-  void OnGetDATFileData(GetDATFileDataResult result);
+  void UpdateAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client,
+                           EngineFactory engine_factory);
+  void PublishAdBlockClient(std::unique_ptr<adblock::Engine> ad_block_client);
+  // Tags and resources can only be applied to an engine before it is
+  // published, so changing them rebuilds the engine from |engine_factory_|.
+  // Changes made within the same task are applied with a single rebuild.
+  void ScheduleRebuildAdBlockClient();
+  void RebuildAdBlockClient();
+  void OnGetDATFileData(const base::FilePath& dat_file_path,
+                        DATFileLoadResult result);
   void OnPreferenceChanges(const std::string& pref_name);
 
+  base::Lock engine_lock_;
+  scoped_refptr<AdBlockEngine> engine_;
+
+  // Builds engines from the rules or the mapped DAT file of the last update.
+  EngineFactory engine_factory_;
   std::vector<std::string> tags_;
   std::string resources_;
+  bool rebuild_pending_ = false;
   base::WeakPtrFactory<AdBlockBaseService> weak_factory_;
   DISALLOW_COPY_AND_ASSIGN(AdBlockBaseService);
 };
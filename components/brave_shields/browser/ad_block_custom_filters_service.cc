@@ -5,10 +5,13 @@
 
 #include "brave/components/brave_shields/browser/ad_block_custom_filters_service.h"
 
+#include <utility>
+
 #include "base/logging.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/browser_thread.h"
@@ -44,19 +47,44 @@ bool AdBlockCustomFiltersService::UpdateCustomFilters(
     return false;
   local_state->SetString(kAdBlockCustomFilters, custom_filters);
 
+  {
+    base::AutoLock lock(latest_custom_filters_lock_);
+    latest_custom_filters_ = custom_filters;
+  }
   GetTaskRunner()->PostTask(
       FROM_HERE,
       base::BindOnce(
           &AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner,
-          base::Unretained(this), custom_filters));
+          base::Unretained(this)));
 
   return true;
 }
 
-void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner(
-    const std::string& custom_filters) {
+void AdBlockCustomFiltersService::UpdateCustomFiltersOnFileTaskRunner() {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
-  ad_block_client_.reset(new adblock::Engine(custom_filters.c_str()));
+  std::string custom_filters;
+  {
+    base::AutoLock lock(latest_custom_filters_lock_);
+    custom_filters = latest_custom_filters_;
+  }
+
+  // adblock-rust can't add or remove rules in a live engine, so at least
+  // avoid rebuilding when an edit doesn't change the effective rules, or
+  // when a later edit in the same burst was already applied.
+  std::vector<std::string> effective_rules =
+      GetEffectiveFilterRules(custom_filters);
+  if (effective_rules_ && *effective_rules_ == effective_rules)
+    return;
+  effective_rules_ = std::move(effective_rules);
+  UpdateAdBlockClientFromRules(custom_filters);
+}
+
+void AdBlockCustomFiltersService::ResetForTest(const std::string& rules,
+                                               const std::string& resources) {
+  // The engine is replaced directly, so forget the rules it was built from
+  // and let the next custom filters update rebuild unconditionally.
+  effective_rules_.reset();
+  AdBlockBaseService::ResetForTest(rules, resources);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -8,7 +8,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/ad_block_base_service.h"
 
 class AdBlockServiceTest;
@@ -29,10 +32,21 @@ class AdBlockCustomFiltersService : public AdBlockBaseService {
 
  protected:
   bool Init() override;
+  void ResetForTest(const std::string& rules,
+                    const std::string& resources) override;
 
  private:
   friend class ::AdBlockServiceTest;
-  void UpdateCustomFiltersOnFileTaskRunner(const std::string& custom_filters);
+  void UpdateCustomFiltersOnFileTaskRunner();
+
+  // The most recent custom filters, written on the UI thread and read on the
+  // task runner so that a burst of edits results in a single engine build.
+  base::Lock latest_custom_filters_lock_;
+  std::string latest_custom_filters_;
+
+  // The effective rules of the published custom filters, used to skip
+  // rebuilding the engine for edits that don't change any rule.
+  base::Optional<std::vector<std::string>> effective_rules_;
 
   DISALLOW_COPY_AND_ASSIGN(AdBlockCustomFiltersService);
 };
@@ -0,0 +1,29 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string>
+#include <vector>
+
+#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using brave_shields::GetEffectiveFilterRules;
+
+TEST(AdBlockCustomFiltersTest, EffectiveRulesIgnoreCommentsAndBlankLines) {
+  std::vector<std::string> expected({"||a.com^", "||b.com^"});
+  EXPECT_EQ(expected,
+            GetEffectiveFilterRules("! comment\n||a.com^\n\n  ||b.com^  \r\n"));
+}
+
+TEST(AdBlockCustomFiltersTest, EffectiveRulesIgnoreOrderAndDuplicates) {
+  EXPECT_EQ(GetEffectiveFilterRules("||a.com^\n||b.com^"),
+            GetEffectiveFilterRules("||b.com^\n||a.com^\n||a.com^"));
+}
+
+TEST(AdBlockCustomFiltersTest, EffectiveRulesDetectChanges) {
+  EXPECT_NE(GetEffectiveFilterRules("||a.com^"),
+            GetEffectiveFilterRules("||a.com^\n##.ad"));
+  EXPECT_TRUE(GetEffectiveFilterRules("! only a comment\n\n").empty());
+}
@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include <functional>
+
+#include "base/no_destructor.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kDefaultShardSize = 256;
+
+}  // namespace
+
+AdBlockDecisionCache::Decision::Decision() = default;
+AdBlockDecisionCache::Decision::Decision(const Decision& other) = default;
+AdBlockDecisionCache::Decision::~Decision() = default;
+
+AdBlockDecisionCache::Shard::Shard(size_t size) : entries(size) {}
+AdBlockDecisionCache::Shard::~Shard() = default;
+
+// static
+AdBlockDecisionCache* AdBlockDecisionCache::GetInstance() {
+  static base::NoDestructor<AdBlockDecisionCache> instance(kDefaultShardSize);
+  return instance.get();
+}
+
+AdBlockDecisionCache::AdBlockDecisionCache(size_t shard_size) {
+  for (size_t i = 0; i < kShardCount; ++i)
+    shards_.push_back(std::make_unique<Shard>(shard_size));
+}
+
+AdBlockDecisionCache::~AdBlockDecisionCache() = default;
+
+// static
+std::string AdBlockDecisionCache::MakeKey(const AdBlockRequest& request) {
+  // URLs can't contain spaces, so they are a safe separator.
+  return request.url_spec + ' ' + request.tab_host + ' ' +
+         request.resource_type_string;
+}
+
+AdBlockDecisionCache::Shard& AdBlockDecisionCache::GetShard(
+    const std::string& key) {
+  return *shards_[std::hash<std::string>()(key) % kShardCount];
+}
+
+bool AdBlockDecisionCache::Get(const std::string& key, Decision* decision) {
+  Shard& shard = GetShard(key);
+  {
+    base::AutoLock lock(shard.lock);
+    auto it = shard.entries.Get(key);
+    if (it != shard.entries.end()) {
+      *decision = it->second;
+      ++hits_;
+      return true;
+    }
+  }
+  ++misses_;
+  return false;
+}
+
+void AdBlockDecisionCache::Put(const std::string& key,
+                               const Decision& decision,
+                               uint64_t generation) {
+  Shard& shard = GetShard(key);
+  base::AutoLock lock(shard.lock);
+  // Checked under the shard lock, so Invalidate() can't clear this shard
+  // between the check and the insertion.
+  if (generation != generation_)
+    return;
+  shard.entries.Put(key, decision);
+}
+
+void AdBlockDecisionCache::Invalidate() {
+  ++generation_;
+  for (const auto& shard : shards_) {
+    base::AutoLock lock(shard->lock);
+    shard->entries.Clear();
+  }
+}
+
+}  // namespace brave_shields
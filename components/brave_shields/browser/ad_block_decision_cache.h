@@ -0,0 +1,87 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace brave_shields {
+
+struct AdBlockRequest;
+
+// Caches the combined result of the default, regional and custom filter
+// engines for a (request URL, tab host, resource type) triple. The cache is
+// split into independently locked shards so lookups from the thread pool
+// rarely contend, and every shard is bounded.
+//
+// Any change to the engines must call Invalidate(). Results computed against
+// an older set of engines are dropped by Put(), so a match that was in
+// flight during an invalidation can't repopulate the cache with a stale
+// decision.
+class AdBlockDecisionCache {
+ public:
+  struct Decision {
+    Decision();
+    Decision(const Decision& other);
+    ~Decision();
+
+    bool should_block = false;
+    bool cancel_request_explicitly = false;
+    std::string mock_data_url;
+  };
+
+  static AdBlockDecisionCache* GetInstance();
+
+  explicit AdBlockDecisionCache(size_t shard_size);
+  ~AdBlockDecisionCache();
+
+  static std::string MakeKey(const AdBlockRequest& request);
+
+  // Must be read before matching and handed to Put() with the result.
+  uint64_t generation() const { return generation_; }
+
+  bool Get(const std::string& key, Decision* decision);
+  void Put(const std::string& key,
+           const Decision& decision,
+           uint64_t generation);
+  void Invalidate();
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+ private:
+  static constexpr size_t kShardCount = 16;
+
+  struct Shard {
+    explicit Shard(size_t size);
+    ~Shard();
+
+    base::Lock lock;
+    base::MRUCache<std::string, Decision> entries;
+  };
+
+  Shard& GetShard(const std::string& key);
+
+  std::atomic<uint64_t> generation_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockDecisionCache);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_DECISION_CACHE_H_
@@ -0,0 +1,59 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
+
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+TEST(AdBlockDecisionCacheTest, KeyDependsOnTabHostAndResourceType) {
+  const GURL url("https://tracker.example.com/t.js");
+  const std::string key = AdBlockDecisionCache::MakeKey(
+      AdBlockRequest(url, blink::mojom::ResourceType::kScript, "brave.com"));
+  EXPECT_NE(key, AdBlockDecisionCache::MakeKey(AdBlockRequest(
+                     url, blink::mojom::ResourceType::kScript, "a.com")));
+  EXPECT_NE(key, AdBlockDecisionCache::MakeKey(AdBlockRequest(
+                     url, blink::mojom::ResourceType::kXhr, "brave.com")));
+}
+
+TEST(AdBlockDecisionCacheTest, GetPutAndCounters) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecisionCache::Decision decision;
+  EXPECT_FALSE(cache.Get("a", &decision));
+
+  AdBlockDecisionCache::Decision blocked;
+  blocked.should_block = true;
+  blocked.mock_data_url = "data:text/javascript,";
+  cache.Put("a", blocked, cache.generation());
+  ASSERT_TRUE(cache.Get("a", &decision));
+  EXPECT_TRUE(decision.should_block);
+  EXPECT_EQ(decision.mock_data_url, "data:text/javascript,");
+
+  EXPECT_EQ(cache.hits(), 1u);
+  EXPECT_EQ(cache.misses(), 1u);
+}
+
+TEST(AdBlockDecisionCacheTest, Invalidate) {
+  AdBlockDecisionCache cache(2);
+  AdBlockDecisionCache::Decision decision;
+  cache.Put("a", decision, cache.generation());
+  cache.Invalidate();
+  EXPECT_FALSE(cache.Get("a", &decision));
+}
+
+TEST(AdBlockDecisionCacheTest, DropsDecisionsFromOlderGeneration) {
+  AdBlockDecisionCache cache(2);
+  const uint64_t generation = cache.generation();
+  cache.Invalidate();
+
+  AdBlockDecisionCache::Decision decision;
+  cache.Put("a", decision, generation);
+  EXPECT_FALSE(cache.Get("a", &decision));
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,88 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_engine.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+#include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+const size_t kCosmeticResourcesCacheSize = 100;
+
+}  // namespace
+
+AdBlockEngine::AdBlockEngine(std::unique_ptr<adblock::Engine> engine)
+    : engine_(std::move(engine)),
+      cosmetic_resources_cache_(kCosmeticResourcesCacheSize) {
+  DCHECK(engine_);
+}
+
+AdBlockEngine::~AdBlockEngine() = default;
+
+bool AdBlockEngine::ShouldStartRequest(const AdBlockRequest& request,
+                                       bool* did_match_exception,
+                                       bool* cancel_request_explicitly,
+                                       std::string* mock_data_url) const {
+  bool explicit_cancel;
+  bool saved_from_exception;
+  if (engine_->matches(
+          request.url_spec, request.url_host, request.tab_host,
+          request.is_third_party, request.resource_type_string,
+          &explicit_cancel, &saved_from_exception, mock_data_url)) {
+    if (cancel_request_explicitly) {
+      *cancel_request_explicitly = explicit_cancel;
+    }
+    // We'd only possibly match an exception filter if we're returning true.
+    if (did_match_exception) {
+      *did_match_exception = false;
+    }
+    // LOG(ERROR) << "AdBlockEngine::ShouldStartRequest(), host: "
+    //  << request.tab_host
+    //  << ", resource type: " << request.resource_type_string
+    //  << ", url.spec(): " << request.url_spec;
+    return false;
+  }
+
+  if (did_match_exception) {
+    *did_match_exception = saved_from_exception;
+  }
+
+  return true;
+}
+
+base::Optional<CosmeticResources> AdBlockEngine::UrlCosmeticResources(
+    const std::string& url) const {
+  const GURL gurl(url);
+  const std::string key = gurl.is_valid() ? gurl.host() : url;
+  {
+    base::AutoLock lock(cosmetic_resources_lock_);
+    auto it = cosmetic_resources_cache_.Get(key);
+    if (it != cosmetic_resources_cache_.end())
+      return it->second;
+  }
+
+  base::Optional<CosmeticResources> resources =
+      CosmeticResources::FromJSON(engine_->urlCosmeticResources(url));
+  base::AutoLock lock(cosmetic_resources_lock_);
+  cosmetic_resources_cache_.Put(key, resources);
+  return resources;
+}
+
+std::vector<std::string> AdBlockEngine::HiddenClassIdSelectors(
+    const std::vector<std::string>& classes,
+    const std::vector<std::string>& ids,
+    const std::vector<std::string>& exceptions) const {
+  return HiddenClassIdSelectorsFromJSON(
+      engine_->hiddenClassIdSelectors(classes, ids, exceptions));
+}
+
+}  // namespace brave_shields
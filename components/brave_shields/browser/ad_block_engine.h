@@ -0,0 +1,65 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/optional.h"
+#include "base/synchronization/lock.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
+
+namespace adblock {
+class Engine;
+}  // namespace adblock
+
+namespace brave_shields {
+
+struct AdBlockRequest;
+
+// A fully configured adblock::Engine. An AdBlockBaseService applies tags and
+// resources before publishing it and never mutates it afterwards, so any
+// thread holding a reference can match against it while a newer engine is
+// swapped in.
+class AdBlockEngine : public base::RefCountedThreadSafe<AdBlockEngine> {
+ public:
+  explicit AdBlockEngine(std::unique_ptr<adblock::Engine> engine);
+
+  bool ShouldStartRequest(const AdBlockRequest& request,
+                          bool* did_match_exception,
+                          bool* cancel_request_explicitly,
+                          std::string* mock_data_url) const;
+
+  // Cosmetic resources only depend on the hostname of |url|, so results are
+  // memoized per hostname for the lifetime of the engine.
+  base::Optional<CosmeticResources> UrlCosmeticResources(
+      const std::string& url) const;
+  std::vector<std::string> HiddenClassIdSelectors(
+      const std::vector<std::string>& classes,
+      const std::vector<std::string>& ids,
+      const std::vector<std::string>& exceptions) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<AdBlockEngine>;
+  ~AdBlockEngine();
+
+  const std::unique_ptr<adblock::Engine> engine_;
+
+  mutable base::Lock cosmetic_resources_lock_;
+  mutable base::MRUCache<std::string, base::Optional<CosmeticResources>>
+      cosmetic_resources_cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(AdBlockEngine);
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_ENGINE_H_
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_shields/browser/ad_block_regional_service_manager.h"
 
+#include <iterator>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "base/values.h"
 #include "brave/browser/brave_browser_process_impl.h"
 #include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/browser/ad_block_decision_cache.h"
 #include "brave/components/brave_shields/browser/ad_block_regional_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service.h"
 #include "brave/components/brave_shields/browser/ad_block_service_helper.h"
@@ -122,11 +124,30 @@ bool AdBlockRegionalServiceManager::ShouldStartRequest(
     bool* matching_exception_filter,
     bool* cancel_request_explicitly,
     std::string* mock_data_url) {
-  base::AutoLock lock(regional_services_lock_);
-  for (const auto& regional_service : regional_services_) {
-    if (!regional_service.second->ShouldStartRequest(
-            url, resource_type, tab_host, matching_exception_filter,
-            cancel_request_explicitly, mock_data_url)) {
+  return ShouldStartRequest(AdBlockRequest(url, resource_type, tab_host),
+                            matching_exception_filter,
+                            cancel_request_explicitly, mock_data_url);
+}
+
+bool AdBlockRegionalServiceManager::ShouldStartRequest(
+    const AdBlockRequest& request,
+    bool* matching_exception_filter,
+    bool* cancel_request_explicitly,
+    std::string* mock_data_url) {
+  // Only hold the lock while collecting the engines, so that matching for
+  // different requests can run concurrently.
+  std::vector<scoped_refptr<AdBlockEngine>> engines;
+  {
+    base::AutoLock lock(regional_services_lock_);
+    engines.reserve(regional_services_.size());
+    for (const auto& regional_service : regional_services_)
+      engines.push_back(regional_service.second->GetEngine());
+  }
+
+  for (const auto& engine : engines) {
+    if (!engine->ShouldStartRequest(request, matching_exception_filter,
+                                    cancel_request_explicitly,
+                                    mock_data_url)) {
       return false;
     }
     if (matching_exception_filter && *matching_exception_filter) {
@@ -173,6 +194,7 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
       regional_services_.erase(it);
     }
   }
+  AdBlockDecisionCache::GetInstance()->Invalidate();
 
   // Update preferences to reflect enabled/disabled state of specified
   // filter list
@@ -182,24 +204,18 @@ void AdBlockRegionalServiceManager::EnableFilterList(const std::string& uuid,
                      base::Unretained(this), uuid, enabled));
 }
 
-base::Optional<base::Value>
+base::Optional<CosmeticResources>
 AdBlockRegionalServiceManager::UrlCosmeticResources(
         const std::string& url) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return base::Optional<base::Value>();
-  }
-  base::Optional<base::Value> first_value =
-      it->second->UrlCosmeticResources(url);
-
-  for ( ; it != regional_services_.end(); it++) {
-    base::Optional<base::Value> next_value =
-        it->second->UrlCosmeticResources(url);
+  base::Optional<CosmeticResources> first_value;
+  for (const auto& regional_service : regional_services_) {
+    base::Optional<CosmeticResources> next_value =
+        regional_service.second->UrlCosmeticResources(url);
+    if (!next_value)
+      continue;
     if (first_value) {
-      if (next_value) {
-        MergeResourcesInto(std::move(*next_value), &*first_value, false);
-      }
+      first_value->MergeFrom(*next_value, false);
     } else {
       first_value = std::move(next_value);
     }
@@ -208,36 +224,23 @@ AdBlockRegionalServiceManager::UrlCosmeticResources(
   return first_value;
 }
 
-base::Optional<base::Value>
+std::vector<std::string>
 AdBlockRegionalServiceManager::HiddenClassIdSelectors(
         const std::vector<std::string>& classes,
         const std::vector<std::string>& ids,
         const std::vector<std::string>& exceptions) {
   base::AutoLock lock(regional_services_lock_);
-  auto it = regional_services_.begin();
-  if (it == regional_services_.end()) {
-    return base::Optional<base::Value>();
-  }
-  base::Optional<base::Value> first_value =
-      it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-
-  for ( ; it != regional_services_.end(); it++) {
-    base::Optional<base::Value> next_value =
-        it->second->HiddenClassIdSelectors(classes, ids, exceptions);
-    if (first_value && first_value->is_list()) {
-      if (next_value && next_value->is_list()) {
-        for (auto i = next_value->GetList().begin();
-                i < next_value->GetList().end();
-                i++) {
-          first_value->Append(std::move(*i));
-        }
-      }
-    } else {
-      first_value = std::move(next_value);
-    }
+  std::vector<std::string> selectors;
+  for (const auto& regional_service : regional_services_) {
+    std::vector<std::string> next_selectors =
+        regional_service.second->HiddenClassIdSelectors(classes, ids,
+                                                        exceptions);
+    selectors.insert(selectors.end(),
+                     std::make_move_iterator(next_selectors.begin()),
+                     std::make_move_iterator(next_selectors.end()));
   }
 
-  return first_value;
+  return selectors;
 }
 
 void AdBlockRegionalServiceManager::SetRegionalCatalog(
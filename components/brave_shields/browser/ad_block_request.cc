@@ -0,0 +1,89 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+using namespace net::registry_controlled_domains;  // NOLINT
+
+namespace brave_shields {
+
+const char* ResourceTypeToString(blink::mojom::ResourceType resource_type) {
+  switch (resource_type) {
+    // top level page
+    case blink::mojom::ResourceType::kMainFrame:
+      return "main_frame";
+    // frame or iframe
+    case blink::mojom::ResourceType::kSubFrame:
+      return "sub_frame";
+    // a CSS stylesheet
+    case blink::mojom::ResourceType::kStylesheet:
+      return "stylesheet";
+    // an external script
+    case blink::mojom::ResourceType::kScript:
+      return "script";
+    // an image (jpg/gif/png/etc)
+    case blink::mojom::ResourceType::kFavicon:
+    case blink::mojom::ResourceType::kImage:
+      return "image";
+    // a font
+    case blink::mojom::ResourceType::kFontResource:
+      return "font";
+    // an "other" subresource.
+    case blink::mojom::ResourceType::kSubResource:
+      return "other";
+    // an object (or embed) tag for a plugin.
+    case blink::mojom::ResourceType::kObject:
+      return "object";
+    // a media resource.
+    case blink::mojom::ResourceType::kMedia:
+      return "media";
+    // a XMLHttpRequest
+    case blink::mojom::ResourceType::kXhr:
+      return "xhr";
+    // a ping request for <a ping>/sendBeacon.
+    case blink::mojom::ResourceType::kPing:
+      return "ping";
+    // the main resource of a dedicated worker.
+    case blink::mojom::ResourceType::kWorker:
+    // the main resource of a shared worker.
+    case blink::mojom::ResourceType::kSharedWorker:
+    // an explicitly requested prefetch
+    case blink::mojom::ResourceType::kPrefetch:
+    // the main resource of a service worker.
+    case blink::mojom::ResourceType::kServiceWorker:
+    // a report of Content Security Policy violations.
+    case blink::mojom::ResourceType::kCspReport:
+    // a resource that a plugin requested.
+    case blink::mojom::ResourceType::kPluginResource:
+    default:
+      return "";
+  }
+}
+
+AdBlockRequest::AdBlockRequest(const GURL& url,
+                               blink::mojom::ResourceType resource_type,
+                               const std::string& tab_host)
+    : url_spec(url.spec()),
+      url_host(url.host()),
+      tab_host(tab_host),
+      // Determine third-party here so the library doesn't need to figure it
+      // out. CreateFromNormalizedTuple is needed because SameDomainOrHost
+      // needs a URL or origin and not a string to a host name.
+      is_third_party(!SameDomainOrHost(
+          url,
+          url::Origin::CreateFromNormalizedTuple("https", tab_host.c_str(), 80),
+          INCLUDE_PRIVATE_REGISTRIES)),
+      resource_type(resource_type),
+      resource_type_string(ResourceTypeToString(resource_type)) {}
+
+AdBlockRequest::AdBlockRequest(const AdBlockRequest& other) = default;
+
+AdBlockRequest::~AdBlockRequest() = default;
+
+}  // namespace brave_shields
@@ -0,0 +1,42 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
+
+#include <string>
+
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom-shared.h"
+
+class GURL;
+
+namespace brave_shields {
+
+// Returns the adblock-rust filter option name for |resource_type|, or an
+// empty string if the type has no filter option.
+const char* ResourceTypeToString(blink::mojom::ResourceType resource_type);
+
+// The request features every adblock engine needs to match a request.
+// Computing them is not free (registry lookups, URL serialization), so they
+// are computed once per request and shared by the default, regional and
+// custom filter engines.
+struct AdBlockRequest {
+  AdBlockRequest(const GURL& url,
+                 blink::mojom::ResourceType resource_type,
+                 const std::string& tab_host);
+  AdBlockRequest(const AdBlockRequest& other);
+  ~AdBlockRequest();
+
+  std::string url_spec;
+  std::string url_host;
+  std::string tab_host;
+  bool is_third_party;
+  blink::mojom::ResourceType resource_type;
+  std::string resource_type_string;
+};
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_AD_BLOCK_REQUEST_H_
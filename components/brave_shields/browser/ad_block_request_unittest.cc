@@ -0,0 +1,36 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/ad_block_request.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+TEST(AdBlockRequestTest, FirstPartyRequest) {
+  AdBlockRequest request(GURL("https://cdn.brave.com/logo.png"),
+                         blink::mojom::ResourceType::kImage, "brave.com");
+  EXPECT_EQ(request.url_spec, "https://cdn.brave.com/logo.png");
+  EXPECT_EQ(request.url_host, "cdn.brave.com");
+  EXPECT_EQ(request.tab_host, "brave.com");
+  EXPECT_FALSE(request.is_third_party);
+  EXPECT_EQ(request.resource_type_string, "image");
+}
+
+TEST(AdBlockRequestTest, ThirdPartyRequest) {
+  AdBlockRequest request(GURL("https://tracker.example.com/t.js"),
+                         blink::mojom::ResourceType::kScript, "brave.com");
+  EXPECT_TRUE(request.is_third_party);
+  EXPECT_EQ(request.resource_type_string, "script");
+}
+
+TEST(AdBlockRequestTest, ResourceTypeWithoutFilterOption) {
+  EXPECT_STREQ(ResourceTypeToString(blink::mojom::ResourceType::kWorker), "");
+  EXPECT_STREQ(ResourceTypeToString(blink::mojom::ResourceType::kFavicon),
+               "image");
+}
+
+}  // namespace brave_shields
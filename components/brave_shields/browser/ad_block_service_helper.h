@@ -9,7 +9,6 @@
 #include <string>
 #include <vector>
 
-#include "base/values.h"
 #include "brave/vendor/adblock_rust_ffi/src/wrapper.hpp"
 
 namespace brave_shields {
@@ -24,7 +23,10 @@ std::vector<adblock::FilterList>::const_iterator FindAdBlockFilterListByLocale(
 std::vector<adblock::FilterList> RegionalCatalogFromJSON(
     const std::string& catalog_json);
 
-void MergeResourcesInto(base::Value from, base::Value* into, bool force_hide);
+// Returns the set of effective filter rules in |filters|: trimmed, sorted and
+// deduplicated, without blank lines and `!` comments. Two filter lists with
+// the same effective rules produce equivalent engines.
+std::vector<std::string> GetEffectiveFilterRules(const std::string& filters);
 
 }  // namespace brave_shields
 
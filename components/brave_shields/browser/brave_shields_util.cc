@@ -388,6 +388,17 @@ bool GetHTTPSEverywhereEnabled(HostContentSettingsMap* map, const GURL& url) {
   return setting == CONTENT_SETTING_ALLOW ? false : true;
 }
 
+ShieldsSettings GetShieldsSettings(HostContentSettingsMap* map,
+                                   const GURL& url) {
+  ShieldsSettings settings;
+  settings.allow_brave_shields = GetBraveShieldsEnabled(map, url);
+  settings.allow_ads = GetAdControlType(map, url) == ControlType::ALLOW;
+  settings.allow_http_upgradable_resource =
+      !GetHTTPSEverywhereEnabled(map, url);
+  settings.allow_referrers = AllowReferrers(map, url);
+  return settings;
+}
+
 void SetNoScriptControlType(HostContentSettingsMap* map,
                             ControlType type,
                             const GURL& url,
@@ -25,6 +25,14 @@ namespace brave_shields {
 
 enum ControlType { ALLOW = 0, BLOCK, BLOCK_THIRD_PARTY, DEFAULT, INVALID };
 
+// The shields settings consulted for every request of a tab.
+struct ShieldsSettings {
+  bool allow_brave_shields = true;
+  bool allow_ads = false;
+  bool allow_http_upgradable_resource = false;
+  bool allow_referrers = false;
+};
+
 ContentSettingsPattern GetPatternFromURL(const GURL& url);
 std::string ControlTypeToString(ControlType type);
 ControlType ControlTypeFromString(const std::string& string);
@@ -80,6 +88,9 @@ void ResetHTTPSEverywhereEnabled(HostContentSettingsMap* map,
                                  const GURL& url);
 bool GetHTTPSEverywhereEnabled(HostContentSettingsMap* map, const GURL& url);
 
+ShieldsSettings GetShieldsSettings(HostContentSettingsMap* map,
+                                   const GURL& url);
+
 void SetNoScriptControlType(HostContentSettingsMap* map,
                             ControlType type,
                             const GURL& url,
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "brave/common/pref_names.h"
 #include "brave/common/render_messages.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
@@ -53,6 +54,13 @@ using content::WebContents;
 
 namespace {
 
+// Blocked events raised within roughly one frame are delivered together.
+constexpr base::TimeDelta kBlockedEventsDispatchDelay =
+    base::TimeDelta::FromMilliseconds(16);
+
+// Blocked counters are written to prefs at most this often per tab.
+constexpr base::TimeDelta kStatsFlushDelay = base::TimeDelta::FromSeconds(2);
+
 // Content Settings are only sent to the main frame currently.
 // Chrome may fix this at some point, but for now we do this as a work-around.
 // You can verify if this is fixed by running the following test:
@@ -131,6 +139,7 @@ bool BraveShieldsWebContentsObserver::RenderFrameIdKey::operator==(
 }
 
 BraveShieldsWebContentsObserver::~BraveShieldsWebContentsObserver() {
+  DCHECK(pending_stats_.empty());
 }
 
 BraveShieldsWebContentsObserver::BraveShieldsWebContentsObserver(
@@ -190,6 +199,11 @@ void BraveShieldsWebContentsObserver::DidFinishNavigation(
   frame_tree_node_id_to_tab_url_[tree_node_id] = web_contents()->GetURL();
 }
 
+void BraveShieldsWebContentsObserver::WebContentsDestroyed() {
+  DispatchPendingBlockedEvents();
+  FlushStats();
+}
+
 // static
 GURL BraveShieldsWebContentsObserver::GetTabURLFromRenderFrameInfo(
     int render_process_id, int render_frame_id, int render_frame_tree_node_id) {
@@ -239,31 +253,86 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEvent(
     if (observer &&
         !observer->IsBlockedSubresource(subresource)) {
       observer->AddBlockedSubresource(subresource);
-      PrefService* prefs = Profile::FromBrowserContext(
-          web_contents->GetBrowserContext())->
-          GetOriginalProfile()->
-          GetPrefs();
 
       if (block_type == kAds) {
-        prefs->SetUint64(kAdsBlocked, prefs->GetUint64(kAdsBlocked) + 1);
+        observer->IncrementStat(kAdsBlocked);
       } else if (block_type == kHTTPUpgradableResources) {
-        prefs->SetUint64(kHttpsUpgrades, prefs->GetUint64(kHttpsUpgrades) + 1);
+        observer->IncrementStat(kHttpsUpgrades);
       } else if (block_type == kJavaScript) {
-        prefs->SetUint64(kJavascriptBlocked,
-            prefs->GetUint64(kJavascriptBlocked) + 1);
+        observer->IncrementStat(kJavascriptBlocked);
       } else if (block_type == kFingerprintingV2) {
-        prefs->SetUint64(kFingerprintingBlocked,
-            prefs->GetUint64(kFingerprintingBlocked) + 1);
+        observer->IncrementStat(kFingerprintingBlocked);
       }
     }
   }
 }
 
-#if !defined(OS_ANDROID)
 // static
 void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
     const std::string& block_type, const std::string& subresource,
     WebContents* web_contents) {
+  if (!web_contents) {
+    return;
+  }
+  BraveShieldsWebContentsObserver* observer =
+      BraveShieldsWebContentsObserver::FromWebContents(web_contents);
+  if (!observer) {
+    DispatchBlockedEventsForWebContents({{block_type, subresource}},
+                                        web_contents);
+    return;
+  }
+  observer->QueueBlockedEvent(block_type, subresource);
+}
+
+void BraveShieldsWebContentsObserver::QueueBlockedEvent(
+    const std::string& block_type,
+    const std::string& subresource) {
+  pending_blocked_events_.push_back({block_type, subresource});
+  if (!blocked_events_timer_.IsRunning()) {
+    blocked_events_timer_.Start(FROM_HERE, kBlockedEventsDispatchDelay, this,
+        &BraveShieldsWebContentsObserver::DispatchPendingBlockedEvents);
+  }
+}
+
+void BraveShieldsWebContentsObserver::DispatchPendingBlockedEvents() {
+  blocked_events_timer_.Stop();
+  if (pending_blocked_events_.empty()) {
+    return;
+  }
+  std::vector<BlockedEvent> events;
+  events.swap(pending_blocked_events_);
+  DispatchBlockedEventsForWebContents(events, web_contents());
+}
+
+void BraveShieldsWebContentsObserver::IncrementStat(const char* pref_name) {
+  ++pending_stats_[pref_name];
+  if (!stats_flush_timer_.IsRunning()) {
+    stats_flush_timer_.Start(FROM_HERE, kStatsFlushDelay, this,
+        &BraveShieldsWebContentsObserver::FlushStats);
+  }
+}
+
+void BraveShieldsWebContentsObserver::FlushStats() {
+  stats_flush_timer_.Stop();
+  if (pending_stats_.empty() || !web_contents()) {
+    return;
+  }
+  PrefService* prefs = Profile::FromBrowserContext(
+      web_contents()->GetBrowserContext())->
+      GetOriginalProfile()->
+      GetPrefs();
+  for (const auto& stat : pending_stats_) {
+    prefs->SetUint64(stat.first.c_str(),
+        prefs->GetUint64(stat.first.c_str()) + stat.second);
+  }
+  pending_stats_.clear();
+}
+
+#if !defined(OS_ANDROID)
+// static
+void BraveShieldsWebContentsObserver::DispatchBlockedEventsForWebContents(
+    const std::vector<BlockedEvent>& events,
+    WebContents* web_contents) {
 #if BUILDFLAG(ENABLE_EXTENSIONS)
   if (!web_contents) {
     return;
@@ -272,10 +341,16 @@ void BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
       Profile::FromBrowserContext(web_contents->GetBrowserContext());
   EventRouter* event_router = EventRouter::Get(profile);
   if (profile && event_router) {
-    extensions::api::brave_shields::OnBlocked::Details details;
-    details.tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
-    details.block_type = block_type;
-    details.subresource = subresource;
+    const int tab_id = extensions::ExtensionTabUtil::GetTabId(web_contents);
+    std::vector<extensions::api::brave_shields::BlockedResource> details;
+    details.reserve(events.size());
+    for (const auto& blocked_event : events) {
+      extensions::api::brave_shields::BlockedResource resource;
+      resource.tab_id = tab_id;
+      resource.block_type = blocked_event.block_type;
+      resource.subresource = blocked_event.subresource;
+      details.push_back(std::move(resource));
+    }
     std::unique_ptr<base::ListValue> args(
         extensions::api::brave_shields::OnBlocked::Create(details)
           .release());
@@ -339,6 +414,13 @@ void BraveShieldsWebContentsObserver::RegisterProfilePrefs(
 
 void BraveShieldsWebContentsObserver::ReadyToCommitNavigation(
     content::NavigationHandle* navigation_handle) {
+  // The panel resets its counts when a new document commits, so blocks from
+  // the old document must not arrive after that
+  if (navigation_handle->IsInMainFrame() &&
+      !navigation_handle->IsSameDocument()) {
+    DispatchPendingBlockedEvents();
+  }
+
   // when the main frame navigate away
   if (navigation_handle->IsInMainFrame() &&
       !navigation_handle->IsSameDocument() &&
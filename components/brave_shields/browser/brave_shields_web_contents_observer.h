@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_BRAVE_SHIELDS_WEB_CONTENTS_OBSERVER_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <set>
 #include <string>
@@ -14,6 +16,7 @@
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/strings/string16.h"
+#include "base/timer/timer.h"
 #include "content/public/browser/web_contents_observer.h"
 #include "content/public/browser/web_contents_user_data.h"
 
@@ -48,6 +51,8 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
                         content::WebContents* web_contents);
   bool IsBlockedSubresource(const std::string& subresource);
   void AddBlockedSubresource(const std::string& subresource);
+  // Writes the in-memory blocked counters of this tab to the profile prefs.
+  void FlushStats();
 
  protected:
     // A set of identifiers that uniquely identifies a RenderFrame.
@@ -74,6 +79,7 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
       content::NavigationHandle* navigation_handle) override;
   void DidFinishNavigation(
       content::NavigationHandle* navigation_handle) override;
+  void WebContentsDestroyed() override;
 
   // Invoked if an IPC message is coming from a specific RenderFrameHost.
   bool OnMessageReceived(const IPC::Message& message,
@@ -94,11 +100,37 @@ class BraveShieldsWebContentsObserver : public content::WebContentsObserver,
 
  private:
   friend class content::WebContentsUserData<BraveShieldsWebContentsObserver>;
+  friend class BraveShieldsWebContentsObserverTest;
+
+  struct BlockedEvent {
+    std::string block_type;
+    std::string subresource;
+  };
+
+  // Platform specific delivery of a batch of blocked events for a tab.
+  static void DispatchBlockedEventsForWebContents(
+      const std::vector<BlockedEvent>& events,
+      content::WebContents* web_contents);
+
+  void QueueBlockedEvent(const std::string& block_type,
+                         const std::string& subresource);
+  void DispatchPendingBlockedEvents();
+  void IncrementStat(const char* pref_name);
+
   std::vector<std::string> allowed_script_origins_;
   // We keep a set of the current page's blocked URLs in case the page
   // continually tries to load the same blocked URLs.
   std::set<std::string> blocked_url_paths_;
 
+  // Blocked events are coalesced so that a burst of blocked subresources
+  // results in a single event per tab instead of one per subresource.
+  std::vector<BlockedEvent> pending_blocked_events_;
+  base::OneShotTimer blocked_events_timer_;
+
+  // Blocked counters not yet written to prefs, keyed by pref name.
+  std::map<std::string, uint64_t> pending_stats_;
+  base::OneShotTimer stats_flush_timer_;
+
   WEB_CONTENTS_USER_DATA_KEY_DECL();
   DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserver);
 };
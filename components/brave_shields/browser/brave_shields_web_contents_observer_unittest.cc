@@ -0,0 +1,122 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/brave_shields_web_contents_observer.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "brave/common/extensions/api/brave_shields.h"
+#include "brave/common/pref_names.h"
+#include "brave/components/brave_shields/common/brave_shield_constants.h"
+#include "chrome/browser/profiles/profile.h"
+#include "chrome/test/base/chrome_render_view_host_test_harness.h"
+#include "components/prefs/pref_service.h"
+#include "extensions/browser/event_router.h"
+#include "extensions/browser/event_router_factory.h"
+#include "extensions/browser/test_event_router_observer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_shields {
+
+namespace {
+
+std::unique_ptr<KeyedService> BuildEventRouter(
+    content::BrowserContext* context) {
+  return std::make_unique<extensions::EventRouter>(context, nullptr);
+}
+
+}  // namespace
+
+class BraveShieldsWebContentsObserverTest
+    : public ChromeRenderViewHostTestHarness {
+ public:
+  BraveShieldsWebContentsObserverTest()
+      : ChromeRenderViewHostTestHarness(
+            base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    ChromeRenderViewHostTestHarness::SetUp();
+    extensions::EventRouterFactory::GetInstance()->SetTestingFactory(
+        profile(), base::BindRepeating(&BuildEventRouter));
+    BraveShieldsWebContentsObserver::CreateForWebContents(web_contents());
+  }
+
+ protected:
+  void IncrementStat(const char* pref_name) {
+    BraveShieldsWebContentsObserver::FromWebContents(web_contents())
+        ->IncrementStat(pref_name);
+  }
+
+  uint64_t GetAdsBlocked() {
+    return profile()->GetPrefs()->GetUint64(kAdsBlocked);
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BraveShieldsWebContentsObserverTest);
+};
+
+TEST_F(BraveShieldsWebContentsObserverTest, CoalesceBlockedEvents) {
+  extensions::TestEventRouterObserver event_observer(
+      extensions::EventRouter::Get(profile()));
+
+  BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
+      kAds, "https://a.com/ad.js", web_contents());
+  BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
+      kAds, "https://b.com/ad.js", web_contents());
+  BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
+      kTrackers, "https://c.com/tracker.js", web_contents());
+  EXPECT_TRUE(event_observer.events().empty());
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromMilliseconds(100));
+
+  const auto& events = event_observer.events();
+  ASSERT_EQ(events.size(), 1u);
+  const auto iter =
+      events.find(extensions::api::brave_shields::OnBlocked::kEventName);
+  ASSERT_NE(iter, events.end());
+  ASSERT_EQ(iter->second->event_args->GetList().size(), 1u);
+  EXPECT_EQ(iter->second->event_args->GetList()[0].GetList().size(), 3u);
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest,
+       DispatchBlockedEventsBeforeMainFrameNavigation) {
+  NavigateAndCommit(GURL("https://a.com/"));
+  extensions::TestEventRouterObserver event_observer(
+      extensions::EventRouter::Get(profile()));
+
+  BraveShieldsWebContentsObserver::DispatchBlockedEventForWebContents(
+      kAds, "https://a.com/ad.js", web_contents());
+  EXPECT_TRUE(event_observer.events().empty());
+
+  NavigateAndCommit(GURL("https://b.com/"));
+
+  const auto& events = event_observer.events();
+  ASSERT_EQ(events.size(), 1u);
+  const auto iter =
+      events.find(extensions::api::brave_shields::OnBlocked::kEventName);
+  ASSERT_NE(iter, events.end());
+  EXPECT_EQ(iter->second->event_args->GetList()[0].GetList().size(), 1u);
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, FlushStatsAfterDelay) {
+  IncrementStat(kAdsBlocked);
+  IncrementStat(kAdsBlocked);
+  EXPECT_EQ(GetAdsBlocked(), 0u);
+
+  task_environment()->FastForwardBy(base::TimeDelta::FromSeconds(5));
+  EXPECT_EQ(GetAdsBlocked(), 2u);
+}
+
+TEST_F(BraveShieldsWebContentsObserverTest, FlushStatsOnWebContentsDestroyed) {
+  IncrementStat(kAdsBlocked);
+  EXPECT_EQ(GetAdsBlocked(), 0u);
+
+  DeleteContents();
+  EXPECT_EQ(GetAdsBlocked(), 1u);
+}
+
+}  // namespace brave_shields
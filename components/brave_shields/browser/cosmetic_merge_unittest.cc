@@ -4,7 +4,7 @@
  * You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "base/json/json_reader.h"
-#include "brave/components/brave_shields/browser/ad_block_service_helper.h"
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -22,19 +22,19 @@ class CosmeticResourceMergeTest : public testing::Test {
           const std::string& b,
           bool force_hide,
           const std::string& expected) {
-    base::Optional<base::Value> a_val = base::JSONReader::Read(a);
+    base::Optional<CosmeticResources> a_val = CosmeticResources::FromJSON(a);
     ASSERT_TRUE(a_val);
 
-    base::Optional<base::Value> b_val = base::JSONReader::Read(b);
+    base::Optional<CosmeticResources> b_val = CosmeticResources::FromJSON(b);
     ASSERT_TRUE(b_val);
 
     const base::Optional<base::Value> expected_val =
         base::JSONReader::Read(expected);
     ASSERT_TRUE(expected_val);
 
-    MergeResourcesInto(std::move(b_val.value()), &*a_val, force_hide);
+    a_val->MergeFrom(*b_val, force_hide);
 
-    ASSERT_EQ(*a_val, *expected_val);
+    ASSERT_EQ(a_val->ToValue(), *expected_val);
   }
 
  protected:
@@ -0,0 +1,130 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/cosmetic_resources.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+
+namespace brave_shields {
+
+namespace {
+
+void AppendStrings(const base::Value* list, std::vector<std::string>* into) {
+  if (!list || !list->is_list())
+    return;
+  for (const base::Value& item : list->GetList()) {
+    if (item.is_string())
+      into->push_back(item.GetString());
+  }
+}
+
+base::Value ToListValue(const std::vector<std::string>& strings) {
+  base::Value list(base::Value::Type::LIST);
+  for (const std::string& item : strings)
+    list.Append(item);
+  return list;
+}
+
+}  // namespace
+
+CosmeticResources::CosmeticResources() = default;
+CosmeticResources::CosmeticResources(const CosmeticResources& other) = default;
+CosmeticResources::CosmeticResources(CosmeticResources&& other) = default;
+CosmeticResources& CosmeticResources::operator=(
+    const CosmeticResources& other) = default;
+CosmeticResources& CosmeticResources::operator=(CosmeticResources&& other) =
+    default;
+CosmeticResources::~CosmeticResources() = default;
+
+// static
+base::Optional<CosmeticResources> CosmeticResources::FromValue(
+    const base::Value& value) {
+  if (!value.is_dict())
+    return base::nullopt;
+
+  CosmeticResources resources;
+  AppendStrings(value.FindKey("hide_selectors"), &resources.hide_selectors);
+  const base::Value* force_hide_selectors =
+      value.FindListKey("force_hide_selectors");
+  if (force_hide_selectors) {
+    resources.force_hide_selectors.emplace();
+    AppendStrings(force_hide_selectors, &*resources.force_hide_selectors);
+  }
+  const base::Value* style_selectors = value.FindDictKey("style_selectors");
+  if (style_selectors) {
+    for (const auto& item : style_selectors->DictItems())
+      AppendStrings(&item.second, &resources.style_selectors[item.first]);
+  }
+  AppendStrings(value.FindKey("exceptions"), &resources.exceptions);
+  const std::string* injected_script = value.FindStringKey("injected_script");
+  if (injected_script)
+    resources.injected_script = *injected_script;
+  resources.generichide = value.FindBoolKey("generichide").value_or(false);
+  return resources;
+}
+
+// static
+base::Optional<CosmeticResources> CosmeticResources::FromJSON(
+    const std::string& json) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value)
+    return base::nullopt;
+  return FromValue(*value);
+}
+
+base::Value CosmeticResources::ToValue() const {
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey("hide_selectors", ToListValue(hide_selectors));
+  if (force_hide_selectors)
+    value.SetKey("force_hide_selectors", ToListValue(*force_hide_selectors));
+  base::Value style_selectors_value(base::Value::Type::DICTIONARY);
+  for (const auto& item : style_selectors)
+    style_selectors_value.SetKey(item.first, ToListValue(item.second));
+  value.SetKey("style_selectors", std::move(style_selectors_value));
+  value.SetKey("exceptions", ToListValue(exceptions));
+  value.SetStringKey("injected_script", injected_script);
+  value.SetBoolKey("generichide", generichide);
+  return value;
+}
+
+void CosmeticResources::MergeFrom(const CosmeticResources& from,
+                                  bool force_hide) {
+  std::vector<std::string>* into_hide_selectors = &hide_selectors;
+  if (force_hide) {
+    if (!force_hide_selectors)
+      force_hide_selectors.emplace();
+    into_hide_selectors = &*force_hide_selectors;
+  }
+  into_hide_selectors->insert(into_hide_selectors->end(),
+                              from.hide_selectors.begin(),
+                              from.hide_selectors.end());
+
+  for (const auto& item : from.style_selectors) {
+    std::vector<std::string>& into_styles = style_selectors[item.first];
+    into_styles.insert(into_styles.end(), item.second.begin(),
+                       item.second.end());
+  }
+
+  exceptions.insert(exceptions.end(), from.exceptions.begin(),
+                    from.exceptions.end());
+
+  injected_script += '\n' + from.injected_script;
+
+  if (from.generichide)
+    generichide = true;
+}
+
+std::vector<std::string> HiddenClassIdSelectorsFromJSON(
+    const std::string& json) {
+  std::vector<std::string> selectors;
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (value)
+    AppendStrings(&*value, &selectors);
+  return selectors;
+}
+
+}  // namespace brave_shields
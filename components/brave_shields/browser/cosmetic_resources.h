@@ -0,0 +1,54 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
+#define BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/optional.h"
+#include "base/values.h"
+
+namespace brave_shields {
+
+// Typed form of the url-specific cosmetic resources returned by an adblock
+// engine. Resources from several engines are merged in this form and only
+// converted to a base::Value when handed to the extension.
+struct CosmeticResources {
+  CosmeticResources();
+  CosmeticResources(const CosmeticResources& other);
+  CosmeticResources(CosmeticResources&& other);
+  CosmeticResources& operator=(const CosmeticResources& other);
+  CosmeticResources& operator=(CosmeticResources&& other);
+  ~CosmeticResources();
+
+  // Returns base::nullopt unless |value| is a dictionary.
+  static base::Optional<CosmeticResources> FromValue(const base::Value& value);
+  static base::Optional<CosmeticResources> FromJSON(const std::string& json);
+
+  base::Value ToValue() const;
+
+  // Merges |from| into this object. If |force_hide| is true, the
+  // `hide_selectors` of |from| are added to `force_hide_selectors` instead.
+  void MergeFrom(const CosmeticResources& from, bool force_hide);
+
+  std::vector<std::string> hide_selectors;
+  // Only present once resources were merged with |force_hide|.
+  base::Optional<std::vector<std::string>> force_hide_selectors;
+  std::map<std::string, std::vector<std::string>> style_selectors;
+  std::vector<std::string> exceptions;
+  std::string injected_script;
+  bool generichide = false;
+};
+
+// Parses the list of selectors returned for hidden classes and ids.
+std::vector<std::string> HiddenClassIdSelectorsFromJSON(
+    const std::string& json);
+
+}  // namespace brave_shields
+
+#endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_BROWSER_COSMETIC_RESOURCES_H_
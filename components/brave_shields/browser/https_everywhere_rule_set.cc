@@ -0,0 +1,117 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+
+#include <utility>
+
+#include "base/json/json_reader.h"
+#include "base/memory/ptr_util.h"
+#include "base/values.h"
+#include "third_party/re2/src/re2/re2.h"
+
+namespace brave_shields {
+
+std::string CorrectToRuleToRE2Engine(const std::string& to) {
+  std::string corrected_to(to);
+  size_t pos = corrected_to.find("$");
+  while (std::string::npos != pos) {
+    corrected_to[pos] = '\\';
+    pos = corrected_to.find("$", pos + 1);
+  }
+
+  return corrected_to;
+}
+
+HTTPSERuleSet::Rule::Rule() = default;
+HTTPSERuleSet::Rule::Rule(Rule&& other) = default;
+HTTPSERuleSet::Rule::~Rule() = default;
+
+HTTPSERuleSet::Target::Target() = default;
+HTTPSERuleSet::Target::Target(Target&& other) = default;
+HTTPSERuleSet::Target::~Target() = default;
+
+HTTPSERuleSet::HTTPSERuleSet() = default;
+HTTPSERuleSet::~HTTPSERuleSet() = default;
+
+// static
+std::unique_ptr<HTTPSERuleSet> HTTPSERuleSet::Parse(const std::string& json) {
+  base::Optional<base::Value> json_object = base::JSONReader::Read(json);
+  if (!json_object || !json_object->is_list())
+    return nullptr;
+
+  auto rule_set = base::WrapUnique(new HTTPSERuleSet());
+  for (const base::Value& target_value : json_object->GetList()) {
+    if (!target_value.is_dict())
+      continue;
+
+    Target target;
+    const base::Value* exclusions = target_value.FindListKey("e");
+    if (exclusions) {
+      for (const base::Value& exclusion : exclusions->GetList()) {
+        if (!exclusion.is_dict())
+          continue;
+        const std::string* pattern = exclusion.FindStringKey("p");
+        if (!pattern)
+          continue;
+        auto regex =
+            std::make_unique<re2::RE2>(CorrectToRuleToRE2Engine(*pattern));
+        if (!regex->ok())
+          continue;
+        target.exclusions.push_back(std::move(regex));
+      }
+    }
+
+    // A target without a rules list ends the evaluation with no match, so
+    // nothing after it can ever apply.
+    const base::Value* rules = target_value.FindListKey("r");
+    if (!rules)
+      break;
+
+    for (const base::Value& rule_value : rules->GetList()) {
+      if (!rule_value.is_dict())
+        continue;
+      Rule rule;
+      if (rule_value.FindKey("d")) {
+        rule.is_default = true;
+        target.rules.push_back(std::move(rule));
+        // Default rules always apply, so later rules are unreachable.
+        break;
+      }
+      const std::string* from = rule_value.FindStringKey("f");
+      const std::string* to = rule_value.FindStringKey("t");
+      if (!from || !to)
+        continue;
+      rule.from = std::make_unique<re2::RE2>(*from);
+      if (!rule.from->ok())
+        continue;
+      rule.to = CorrectToRuleToRE2Engine(*to);
+      target.rules.push_back(std::move(rule));
+    }
+    rule_set->targets_.push_back(std::move(target));
+  }
+
+  return rule_set;
+}
+
+std::string HTTPSERuleSet::Apply(const std::string& url) const {
+  for (const Target& target : targets_) {
+    for (const auto& exclusion : target.exclusions) {
+      if (re2::RE2::FullMatch(url, *exclusion))
+        return "";
+    }
+
+    for (const Rule& rule : target.rules) {
+      std::string new_url(url);
+      if (rule.is_default)
+        return new_url.insert(4, "s");
+      if (re2::RE2::Replace(&new_url, *rule.from, rule.to) && new_url != url)
+        return new_url;
+    }
+  }
+  return "";
+}
+
+}  // namespace brave_shields
@@ -0,0 +1,82 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+#include <string>
+
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace brave_shields {
+
+namespace {
+
+const char kRuleSet[] =
+    "[{"
+    "\"e\": [{\"p\": \"^http://example\\\\.com/excluded/\"}],"
+    "\"r\": [{\"f\": \"^http://(www\\\\.)?example\\\\.com/\","
+    "        \"t\": \"https://$1example.com/\"}]"
+    "}]";
+
+}  // namespace
+
+TEST(HTTPSERuleSetTest, InvalidJson) {
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{"));
+  EXPECT_FALSE(HTTPSERuleSet::Parse("{\"r\": []}"));
+}
+
+TEST(HTTPSERuleSetTest, AppliesRewriteRule) {
+  std::unique_ptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(kRuleSet);
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://www.example.com/page"),
+            "https://www.example.com/page");
+  EXPECT_EQ(rule_set->Apply("http://example.com/page"),
+            "https://example.com/page");
+  EXPECT_EQ(rule_set->Apply("http://other.com/"), "");
+}
+
+TEST(HTTPSERuleSetTest, HonorsExclusions) {
+  std::unique_ptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(kRuleSet);
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://example.com/excluded/page"), "");
+}
+
+TEST(HTTPSERuleSetTest, DefaultRule) {
+  std::unique_ptr<HTTPSERuleSet> rule_set =
+      HTTPSERuleSet::Parse("[{\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->Apply("http://brave.com/"), "https://brave.com/");
+}
+
+TEST(HTTPSERuleSetTest, TargetWithoutRulesStopsEvaluation) {
+  std::unique_ptr<HTTPSERuleSet> rule_set =
+      HTTPSERuleSet::Parse("[{\"e\": []}, {\"r\": [{\"d\": 1}]}]");
+  ASSERT_TRUE(rule_set);
+  EXPECT_EQ(rule_set->target_count(), 0u);
+  EXPECT_EQ(rule_set->Apply("http://brave.com/"), "");
+}
+
+TEST(HTTPSERuleSetTest, CorrectToRuleToRE2Engine) {
+  EXPECT_EQ(CorrectToRuleToRE2Engine("https://$1.$2/"), "https://\\1.\\2/");
+  EXPECT_EQ(CorrectToRuleToRE2Engine("https://a/"), "https://a/");
+}
+
+// Compares applying a precompiled ruleset with parsing and compiling it for
+// every lookup, which is what HTTPSEverywhereService used to do on each miss.
+TEST(HTTPSERuleSetTest, DISABLED_Benchmark) {
+  const int kIterations = 10000;
+  const std::string url = "http://www.example.com/some/path?q=1";
+  const std::string expected_url = "https://www.example.com/some/path?q=1";
+
+  for (int i = 0; i < kIterations; ++i)
+    ASSERT_EQ(HTTPSERuleSet::Parse(kRuleSet)->Apply(url), expected_url);
+
+  std::unique_ptr<HTTPSERuleSet> rule_set = HTTPSERuleSet::Parse(kRuleSet);
+  ASSERT_TRUE(rule_set);
+  for (int i = 0; i < kIterations; ++i)
+    ASSERT_EQ(rule_set->Apply(url), expected_url);
+}
+
+}  // namespace brave_shields
@@ -10,12 +10,14 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
 #include "brave/components/brave_shields/browser/base_brave_shields_service.h"
 #include "brave/components/brave_shields/browser/https_everywhere_recently_used_cache.h"
+#include "brave/components/brave_shields/browser/https_everywhere_rule_set.h"
 
 namespace leveldb {
 class DB;
@@ -63,9 +65,9 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
 
   void AddHTTPSEUrlToRedirectList(const uint64_t& request_id);
   bool ShouldHTTPSERedirect(const uint64_t& request_id);
-  std::string ApplyHTTPSRule(const std::string& originalUrl,
-      const std::string& rule);
-  std::string CorrecttoRuleToRE2Engine(const std::string& to);
+  // Returns the compiled ruleset stored under |key|, or nullptr if there is
+  // none. Results, including misses, are kept in |compiled_rule_sets_|.
+  const HTTPSERuleSet* GetRuleSet(const std::string& key);
 
  private:
   friend class ::HTTPSEverywhereServiceTest;
@@ -84,6 +86,8 @@ class HTTPSEverywhereService : public BaseBraveShieldsService,
   base::Lock httpse_get_urls_redirects_count_mutex_;
   std::vector<HTTPSE_REDIRECTS_COUNT_ST> httpse_urls_redirects_count_;
   HTTPSERecentlyUsedCache<std::string> recently_used_cache_;
+  base::MRUCache<std::string, std::unique_ptr<HTTPSERuleSet>>
+      compiled_rule_sets_;
   leveldb::DB* level_db_;
 
   SEQUENCE_CHECKER(sequence_checker_);
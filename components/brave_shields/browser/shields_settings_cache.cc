@@ -0,0 +1,70 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave_shields {
+
+namespace {
+
+// Enough for the top frames of all open tabs in a typical session.
+const size_t kMaxCachedOrigins = 64;
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(
+    HostContentSettingsMap* host_content_settings_map)
+    : host_content_settings_map_(host_content_settings_map),
+      settings_(kMaxCachedOrigins) {
+  DCHECK(host_content_settings_map_);
+  host_content_settings_map_->AddObserver(this);
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() {
+  Shutdown();
+}
+
+ShieldsSettings ShieldsSettingsCache::Get(const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!host_content_settings_map_) {
+    return ShieldsSettings();
+  }
+
+  auto it = settings_.Get(tab_origin);
+  if (it != settings_.end()) {
+    return it->second;
+  }
+
+  const ShieldsSettings settings =
+      GetShieldsSettings(host_content_settings_map_, tab_origin);
+  settings_.Put(tab_origin, settings);
+  return settings;
+}
+
+void ShieldsSettingsCache::Shutdown() {
+  if (host_content_settings_map_) {
+    host_content_settings_map_->RemoveObserver(this);
+    host_content_settings_map_ = nullptr;
+  }
+  settings_.Clear();
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsType content_type,
+    const std::string& resource_identifier) {
+  // Shields settings are stored as plugin resources. A change notification
+  // for the default type means that every type may have changed.
+  if (content_type == ContentSettingsType::PLUGINS ||
+      content_type == ContentSettingsType::DEFAULT) {
+    settings_.Clear();
+  }
+}
+
+}  // namespace brave_shields
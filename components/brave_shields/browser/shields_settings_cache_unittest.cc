@@ -0,0 +1,86 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <memory>
+
+#include "base/macros.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "brave/components/brave_shields/browser/shields_settings_cache.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/testing_profile.h"
+#include "components/content_settings/core/browser/host_content_settings_map.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using brave_shields::ControlType;
+using brave_shields::ShieldsSettings;
+using brave_shields::ShieldsSettingsCache;
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest() = default;
+  ~ShieldsSettingsCacheTest() override = default;
+
+  void SetUp() override {
+    profile_ = std::make_unique<TestingProfile>();
+    cache_ = std::make_unique<ShieldsSettingsCache>(map());
+  }
+
+  void TearDown() override {
+    cache_->Shutdown();
+  }
+
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(profile_.get());
+  }
+
+  ShieldsSettingsCache* cache() { return cache_.get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  std::unique_ptr<TestingProfile> profile_;
+  std::unique_ptr<ShieldsSettingsCache> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(ShieldsSettingsCacheTest);
+};
+
+TEST_F(ShieldsSettingsCacheTest, MatchesContentSettings) {
+  const GURL origin("https://brave.com/");
+  brave_shields::SetAdControlType(map(), ControlType::ALLOW, origin);
+
+  const ShieldsSettings settings = cache()->Get(origin);
+  const ShieldsSettings expected =
+      brave_shields::GetShieldsSettings(map(), origin);
+  EXPECT_EQ(expected.allow_brave_shields, settings.allow_brave_shields);
+  EXPECT_EQ(expected.allow_ads, settings.allow_ads);
+  EXPECT_EQ(expected.allow_http_upgradable_resource,
+            settings.allow_http_upgradable_resource);
+  EXPECT_EQ(expected.allow_referrers, settings.allow_referrers);
+  EXPECT_TRUE(settings.allow_ads);
+}
+
+TEST_F(ShieldsSettingsCacheTest, InvalidatedOnShieldsChange) {
+  const GURL origin("https://brave.com/");
+  EXPECT_TRUE(cache()->Get(origin).allow_brave_shields);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, origin);
+  EXPECT_FALSE(cache()->Get(origin).allow_brave_shields);
+
+  brave_shields::SetHTTPSEverywhereEnabled(map(), false, origin);
+  EXPECT_TRUE(cache()->Get(origin).allow_http_upgradable_resource);
+
+  brave_shields::ResetBraveShieldsEnabled(map(), origin);
+  EXPECT_TRUE(cache()->Get(origin).allow_brave_shields);
+}
+
+TEST_F(ShieldsSettingsCacheTest, KeyedByOrigin) {
+  const GURL origin("https://brave.com/");
+  const GURL other_origin("https://example.com/");
+  brave_shields::SetBraveShieldsEnabled(map(), false, origin);
+
+  EXPECT_FALSE(cache()->Get(origin).allow_brave_shields);
+  EXPECT_TRUE(cache()->Get(other_origin).allow_brave_shields);
+}
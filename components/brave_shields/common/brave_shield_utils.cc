@@ -5,34 +5,37 @@
 
 #include "brave/components/brave_shields/common/brave_shield_utils.h"
 
-#include "base/optional.h"
+#include <vector>
+
+#include "base/logging.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
 #include "url/gurl.h"
 
 ContentSetting GetBraveFPContentSettingFromRules(
-    const ContentSettingsForOneType& fp_rules,
+    const std::vector<const ContentSettingPatternSource*>& fp_rules,
     const GURL& primary_url) {
-  base::Optional<ContentSettingPatternSource> global_fp_rule;
-  base::Optional<ContentSettingPatternSource> global_fp_balanced_rule;
-
-  for (const auto& rule : fp_rules) {
-    if (rule.primary_pattern != ContentSettingsPattern::Wildcard() &&
-        rule.primary_pattern.Matches(primary_url)) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+  const ContentSettingPatternSource* global_fp_rule = nullptr;
+  const ContentSettingPatternSource* global_fp_balanced_rule = nullptr;
+  const ContentSettingsPattern wildcard = ContentSettingsPattern::Wildcard();
+  const ContentSettingsPattern balanced =
+      ContentSettingsPattern::FromString("https://balanced");
+
+  for (const ContentSettingPatternSource* rule : fp_rules) {
+    if (rule->primary_pattern != wildcard &&
+        rule->primary_pattern.Matches(primary_url)) {
+      if (rule->secondary_pattern == balanced) {
         return CONTENT_SETTING_DEFAULT;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard())
-        return rule.GetContentSetting();
+      if (rule->secondary_pattern == wildcard)
+        return rule->GetContentSetting();
     }
 
-    if (rule.primary_pattern == ContentSettingsPattern::Wildcard()) {
-      if (rule.secondary_pattern ==
-          ContentSettingsPattern::FromString("https://balanced")) {
+    if (rule->primary_pattern == wildcard) {
+      if (rule->secondary_pattern == balanced) {
         DCHECK(!global_fp_rule);
         global_fp_balanced_rule = rule;
       }
-      if (rule.secondary_pattern == ContentSettingsPattern::Wildcard()) {
+      if (rule->secondary_pattern == wildcard) {
         DCHECK(!global_fp_balanced_rule);
         global_fp_rule = rule;
       }
@@ -47,3 +50,13 @@ ContentSetting GetBraveFPContentSettingFromRules(
 
   return CONTENT_SETTING_DEFAULT;
 }
+
+ContentSetting GetBraveFPContentSettingFromRules(
+    const ContentSettingsForOneType& fp_rules,
+    const GURL& primary_url) {
+  std::vector<const ContentSettingPatternSource*> rules;
+  rules.reserve(fp_rules.size());
+  for (const auto& rule : fp_rules)
+    rules.push_back(&rule);
+  return GetBraveFPContentSettingFromRules(rules, primary_url);
+}
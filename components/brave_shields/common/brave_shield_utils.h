@@ -6,6 +6,8 @@
 #ifndef BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
 #define BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
 
+#include <vector>
+
 #include "components/content_settings/core/common/content_settings.h"
 
 class GURL;
@@ -14,4 +16,10 @@ ContentSetting GetBraveFPContentSettingFromRules(
     const ContentSettingsForOneType& fp_rules,
     const GURL& primary_url);
 
+// Same as above, for a subset of the rules kept in their original order, e.g.
+// the candidates found by a content_settings::ContentSettingRulesIndex.
+ContentSetting GetBraveFPContentSettingFromRules(
+    const std::vector<const ContentSettingPatternSource*>& fp_rules,
+    const GURL& primary_url);
+
 #endif  // BRAVE_COMPONENTS_BRAVE_SHIELDS_COMMON_BRAVE_SHIELD_UTILS_H_
@@ -0,0 +1,76 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_setting_rules_index.h"
+
+#include <algorithm>
+
+#include "base/strings/string_piece.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "url/gurl.h"
+
+namespace content_settings {
+
+ContentSettingRulesIndex::ContentSettingRulesIndex() = default;
+
+ContentSettingRulesIndex::~ContentSettingRulesIndex() = default;
+
+void ContentSettingRulesIndex::Build(const ContentSettingsForOneType& rules,
+                                     int generation) {
+  Clear();
+  rules_ = &rules;
+  generation_ = generation;
+  for (size_t i = 0; i < rules.size(); ++i) {
+    const ContentSettingsPattern& pattern = rules[i].primary_pattern;
+    const std::string& host = pattern.GetHost();
+    if (host.empty() || pattern.MatchesAllHosts())
+      any_host_rules_.push_back(i);
+    else
+      host_rules_[host].push_back(i);
+  }
+}
+
+void ContentSettingRulesIndex::Clear() {
+  rules_ = nullptr;
+  generation_ = 0;
+  host_rules_.clear();
+  any_host_rules_.clear();
+}
+
+bool ContentSettingRulesIndex::IsBuiltFor(
+    const ContentSettingsForOneType& rules,
+    int generation) const {
+  return rules_ == &rules && generation_ == generation;
+}
+
+std::vector<const ContentSettingPatternSource*>
+ContentSettingRulesIndex::GetCandidateRules(const GURL& primary_url) const {
+  std::vector<const ContentSettingPatternSource*> candidates;
+  if (!rules_)
+    return candidates;
+
+  std::vector<size_t> positions(any_host_rules_);
+  // Domain wildcard patterns are keyed by their domain, so look up every
+  // parent domain of the host as well.
+  base::StringPiece host = primary_url.host_piece();
+  while (!host.empty()) {
+    auto it = host_rules_.find(host.as_string());
+    if (it != host_rules_.end()) {
+      positions.insert(positions.end(), it->second.begin(), it->second.end());
+    }
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      break;
+    host.remove_prefix(dot + 1);
+  }
+  std::sort(positions.begin(), positions.end());
+
+  candidates.reserve(positions.size());
+  for (size_t position : positions)
+    candidates.push_back(&(*rules_)[position]);
+  return candidates;
+}
+
+}  // namespace content_settings
@@ -0,0 +1,60 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTING_RULES_INDEX_H_
+#define BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTING_RULES_INDEX_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/macros.h"
+#include "components/content_settings/core/common/content_settings.h"
+
+class GURL;
+
+namespace content_settings {
+
+// Indexes the rules of one content settings type by the host of their primary
+// pattern, so that the rules which may apply to a URL can be found without
+// matching every pattern against it. Rules whose primary pattern isn't tied to
+// a host (e.g. wildcards) are always candidates.
+class ContentSettingRulesIndex {
+ public:
+  ContentSettingRulesIndex();
+  ~ContentSettingRulesIndex();
+
+  // Indexes |rules|, which must outlive this index or be indexed again.
+  // |generation| is the RendererContentSettingRules::generation of the rules
+  // at this point.
+  void Build(const ContentSettingsForOneType& rules, int generation);
+  void Clear();
+
+  // Whether the index was built for |rules| at |generation|, i.e. the rules
+  // haven't been replaced since.
+  bool IsBuiltFor(const ContentSettingsForOneType& rules,
+                  int generation) const;
+
+  // Returns the rules whose primary pattern may match |primary_url|, in the
+  // order of |rules|, i.e. by precedence. Callers still have to check the
+  // patterns of the returned rules.
+  std::vector<const ContentSettingPatternSource*> GetCandidateRules(
+      const GURL& primary_url) const;
+
+ private:
+  const ContentSettingsForOneType* rules_ = nullptr;
+  int generation_ = 0;
+
+  // Positions in |rules_| keyed by primary pattern host.
+  std::unordered_map<std::string, std::vector<size_t>> host_rules_;
+  // Positions in |rules_| of rules that aren't tied to a host.
+  std::vector<size_t> any_host_rules_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContentSettingRulesIndex);
+};
+
+}  // namespace content_settings
+
+#endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_CORE_COMMON_CONTENT_SETTING_RULES_INDEX_H_
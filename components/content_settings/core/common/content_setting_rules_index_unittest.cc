@@ -0,0 +1,105 @@
+/* Copyright (c) 2020 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/content_settings/core/common/content_setting_rules_index.h"
+
+#include <string>
+#include <vector>
+
+#include "components/content_settings/core/common/content_settings.h"
+#include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+using content_settings::ContentSettingRulesIndex;
+
+namespace {
+
+ContentSettingPatternSource MakeRule(const std::string& primary_pattern,
+                                     ContentSetting setting) {
+  return ContentSettingPatternSource(
+      ContentSettingsPattern::FromString(primary_pattern),
+      ContentSettingsPattern::Wildcard(),
+      base::Value::FromUniquePtrValue(
+          content_settings::ContentSettingToValue(setting)),
+      std::string(), false);
+}
+
+// The positions in |rules| of |candidates|.
+std::vector<size_t> Positions(
+    const ContentSettingsForOneType& rules,
+    const std::vector<const ContentSettingPatternSource*>& candidates) {
+  std::vector<size_t> positions;
+  for (const ContentSettingPatternSource* candidate : candidates)
+    positions.push_back(candidate - rules.data());
+  return positions;
+}
+
+}  // namespace
+
+TEST(ContentSettingRulesIndexTest, CandidatesKeepPrecedenceOrder) {
+  RendererContentSettingRules content_setting_rules;
+  ContentSettingsForOneType& rules = content_setting_rules.brave_shields_rules;
+  rules.push_back(MakeRule("https://sub.example.com", CONTENT_SETTING_ALLOW));
+  rules.push_back(MakeRule("[*.]example.com", CONTENT_SETTING_BLOCK));
+  rules.push_back(MakeRule("https://other.com", CONTENT_SETTING_BLOCK));
+  rules.push_back(MakeRule("*", CONTENT_SETTING_ALLOW));
+
+  const int generation = content_setting_rules.generation.value();
+  ContentSettingRulesIndex index;
+  index.Build(rules, generation);
+  EXPECT_TRUE(index.IsBuiltFor(rules, generation));
+
+  EXPECT_EQ(std::vector<size_t>({0, 1, 3}),
+            Positions(rules, index.GetCandidateRules(
+                                 GURL("https://sub.example.com/path"))));
+  EXPECT_EQ(std::vector<size_t>({1, 3}),
+            Positions(rules, index.GetCandidateRules(
+                                 GURL("https://a.b.example.com/"))));
+  EXPECT_EQ(std::vector<size_t>({3}),
+            Positions(rules,
+                      index.GetCandidateRules(GURL("https://brave.com/"))));
+  EXPECT_EQ(std::vector<size_t>({3}),
+            Positions(rules, index.GetCandidateRules(GURL("file:///a.html"))));
+}
+
+TEST(ContentSettingRulesIndexTest, DetectsReplacedRules) {
+  RendererContentSettingRules content_setting_rules;
+  const ContentSettingsForOneType& rules =
+      content_setting_rules.brave_shields_rules;
+  content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("https://example.com", CONTENT_SETTING_BLOCK));
+
+  ContentSettingRulesIndex index;
+  EXPECT_FALSE(
+      index.IsBuiltFor(rules, content_setting_rules.generation.value()));
+  EXPECT_TRUE(index.GetCandidateRules(GURL("https://example.com/")).empty());
+
+  index.Build(rules, content_setting_rules.generation.value());
+  EXPECT_TRUE(
+      index.IsBuiltFor(rules, content_setting_rules.generation.value()));
+
+  // The renderer replaces its rules in place, and the same number of rules
+  // doesn't mean they are unchanged.
+  RendererContentSettingRules new_content_setting_rules;
+  new_content_setting_rules.brave_shields_rules.push_back(
+      MakeRule("https://brave.com", CONTENT_SETTING_BLOCK));
+  content_setting_rules = new_content_setting_rules;
+  EXPECT_FALSE(
+      index.IsBuiltFor(rules, content_setting_rules.generation.value()));
+
+  index.Build(rules, content_setting_rules.generation.value());
+  EXPECT_TRUE(
+      index.IsBuiltFor(rules, content_setting_rules.generation.value()));
+  EXPECT_EQ(std::vector<size_t>({0}),
+            Positions(rules, index.GetCandidateRules(
+                                 GURL("https://brave.com/"))));
+  EXPECT_TRUE(index.GetCandidateRules(GURL("https://example.com/")).empty());
+
+  index.Clear();
+  EXPECT_FALSE(
+      index.IsBuiltFor(rules, content_setting_rules.generation.value()));
+}
@@ -36,6 +36,9 @@
 namespace content_settings {
 namespace {
 
+// Enough for the distinct script and frame origins of a typical page.
+constexpr size_t kMaxCachedBraveShieldsDownOrigins = 64;
+
 GURL GetOriginOrURL(
     const blink::WebFrame* frame) {
   url::Origin top_origin = url::Origin(frame->Top()->GetSecurityOrigin());
@@ -49,16 +52,16 @@ GURL GetOriginOrURL(
   return top_origin.GetURL();
 }
 
-bool IsBraveShieldsDown(const blink::WebFrame* frame,
-                        const GURL& secondary_url,
-                        const ContentSettingsForOneType& rules) {
+bool IsBraveShieldsDown(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    const std::vector<const ContentSettingPatternSource*>& rules) {
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
-  const GURL& primary_url = GetOriginOrURL(frame);
 
-  for (const auto& rule : rules) {
-    if (rule.primary_pattern.Matches(primary_url) &&
-        rule.secondary_pattern.Matches(secondary_url)) {
-      setting = rule.GetContentSetting();
+  for (const ContentSettingPatternSource* rule : rules) {
+    if (rule->primary_pattern.Matches(primary_url) &&
+        rule->secondary_pattern.Matches(secondary_url)) {
+      setting = rule->GetContentSetting();
       break;
     }
   }
@@ -66,6 +69,16 @@ bool IsBraveShieldsDown(const blink::WebFrame* frame,
   return setting == CONTENT_SETTING_BLOCK;
 }
 
+const ContentSettingRulesIndex& GetRulesIndex(
+    const RendererContentSettingRules& content_setting_rules,
+    const ContentSettingsForOneType& rules,
+    ContentSettingRulesIndex* index) {
+  const int generation = content_setting_rules.generation.value();
+  if (!index->IsBuiltFor(rules, generation))
+    index->Build(rules, generation);
+  return *index;
+}
+
 }  // namespace
 
 BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
@@ -74,7 +87,8 @@ BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
     std::unique_ptr<Delegate> delegate)
     : ContentSettingsAgentImpl(render_frame,
                                should_whitelist,
-                               std::move(delegate)) {}
+                               std::move(delegate)),
+      cached_brave_shields_down_(kMaxCachedBraveShieldsDownOrigins) {}
 
 BraveContentSettingsAgentImpl::~BraveContentSettingsAgentImpl() {
 }
@@ -100,6 +114,10 @@ void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
     ui::PageTransition transition) {
   temporarily_allowed_scripts_ =
       std::move(preloaded_temporarily_allowed_scripts_);
+  brave_shields_rules_index_.Clear();
+  fingerprinting_rules_index_.Clear();
+  cached_brave_shields_down_.Clear();
+  cached_farbling_level_.reset();
   ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
 }
 
@@ -179,9 +197,29 @@ void BraveContentSettingsAgentImpl::DidBlockFingerprinting(
 bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
     const blink::WebFrame* frame,
     const GURL& secondary_url) {
-  return !content_setting_rules_ ||
-         ::content_settings::IsBraveShieldsDown(
-             frame, secondary_url, content_setting_rules_->brave_shields_rules);
+  if (!content_setting_rules_)
+    return true;
+
+  // Content setting patterns match web URLs by scheme, host and port, so
+  // those share a decision per origin. Other schemes are rare and not cached.
+  const bool cacheable = secondary_url.SchemeIsHTTPOrHTTPS();
+  const GURL cache_key = cacheable ? secondary_url.GetOrigin() : GURL();
+  if (cacheable) {
+    auto it = cached_brave_shields_down_.Get(cache_key);
+    if (it != cached_brave_shields_down_.end())
+      return it->second;
+  }
+
+  const GURL primary_url = GetOriginOrURL(frame);
+  const bool shields_down = ::content_settings::IsBraveShieldsDown(
+      primary_url, secondary_url,
+      GetRulesIndex(*content_setting_rules_,
+                    content_setting_rules_->brave_shields_rules,
+                    &brave_shields_rules_index_)
+          .GetCandidateRules(primary_url));
+  if (cacheable)
+    cached_brave_shields_down_.Put(cache_key, shields_down);
+  return shields_down;
 }
 
 bool BraveContentSettingsAgentImpl::AllowFingerprinting(
@@ -199,6 +237,9 @@ bool BraveContentSettingsAgentImpl::AllowFingerprinting(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  if (cached_farbling_level_)
+    return *cached_farbling_level_;
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
@@ -208,22 +249,27 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
             url::Origin(frame->GetDocument().GetSecurityOrigin()).GetURL())) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
+      const GURL primary_url = GetOriginOrURL(frame);
       setting = GetBraveFPContentSettingFromRules(
-          content_setting_rules_->fingerprinting_rules,
-          GetOriginOrURL(frame));
+          GetRulesIndex(*content_setting_rules_,
+                        content_setting_rules_->fingerprinting_rules,
+                        &fingerprinting_rules_index_)
+              .GetCandidateRules(primary_url),
+          primary_url);
     }
   }
 
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    cached_farbling_level_ = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    cached_farbling_level_ = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    cached_farbling_level_ = BraveFarblingLevel::BALANCED;
   }
+  return *cached_farbling_level_;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool default_value) {
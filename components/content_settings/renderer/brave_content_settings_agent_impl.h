@@ -10,7 +10,11 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_set.h"
+#include "base/containers/mru_cache.h"
+#include "base/optional.h"
 #include "base/strings/string16.h"
+#include "brave/components/content_settings/core/common/content_setting_rules_index.h"
 #include "brave/third_party/blink/renderer/brave_farbling_constants.h"
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_types.h"
@@ -72,6 +76,17 @@ class BraveContentSettingsAgentImpl : public ContentSettingsAgentImpl {
   // temporary allowed script origins we preloaded for the next load
   base::flat_set<std::string> preloaded_temporarily_allowed_scripts_;
 
+  // Indexes of the shields rules, rebuilt for each document and whenever the
+  // rules are replaced.
+  ContentSettingRulesIndex brave_shields_rules_index_;
+  ContentSettingRulesIndex fingerprinting_rules_index_;
+
+  // Shields and farbling decisions for the current document, like the script
+  // permissions cached by ContentSettingsAgentImpl. Shields decisions only
+  // depend on the origin of the secondary URL, so they are keyed by origin.
+  base::MRUCache<GURL, bool> cached_brave_shields_down_;
+  base::Optional<BraveFarblingLevel> cached_farbling_level_;
+
   DISALLOW_COPY_AND_ASSIGN(BraveContentSettingsAgentImpl);
 };
 
@@ -7,13 +7,17 @@
 #define BRAVE_COMPONENTS_CONTENT_SETTINGS_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_HELPER_H_
 
 #include "third_party/blink/public/platform/web_content_settings_client.h"
+#include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/frame/local_frame.h"
 
+// Uses the decision cached for the frame's document, as this is called from
+// WebGL and canvas APIs which may run thousands of times per animation frame.
 static bool AllowFingerprinting(blink::LocalFrame* frame) {
-  if (!frame || !frame->GetContentSettingsClient()) {
+  if (!frame || !frame->GetContentSettingsClient() || !frame->GetDocument()) {
     return true;
   }
-  return frame->GetContentSettingsClient()->AllowFingerprinting(true);
+  return brave::BraveSessionCache::From(*frame->GetDocument())
+      .AllowFingerprinting();
 }
 
 #endif  // BRAVE_COMPONENTS_CONTENT_SETTINGS_RENDERER_BRAVE_CONTENT_SETTINGS_AGENT_IMPL_HELPER_H_
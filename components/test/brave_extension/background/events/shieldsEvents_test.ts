@@ -15,13 +15,14 @@ describe('shieldsEvents events', () => {
     afterEach(() => {
       spy.mockRestore()
     })
-    it('forward details to actions.resourceBlocked', (cb) => {
+    it('forward each of the details to actions.resourceBlocked', (cb) => {
       chrome.braveShields.onBlocked.addListener((details) => {
-        expect(details).toBe(blockedResource)
-        expect(spy).toBeCalledWith(details)
+        expect(details).toEqual([blockedResource, blockedResource])
+        expect(spy).toHaveBeenCalledTimes(2)
+        expect(spy).toBeCalledWith(blockedResource)
         cb()
       })
-      chrome.braveShields.onBlocked.emit(blockedResource)
+      chrome.braveShields.onBlocked.emit([blockedResource, blockedResource])
     })
   })
 })